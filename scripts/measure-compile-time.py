@@ -0,0 +1,87 @@
+#!/usr/bin/env python
+# Measures the per translation unit cost of including a UnitGuard header.
+#
+# Generates --count translation units that each include --header and use a few Quantity types,
+# compiles them one at a time and reports the wall time per TU. Run it once per header (or per
+# checkout) to compare, e.g.
+#
+#   scripts/measure-compile-time.py --header Quantity.hpp
+#   scripts/measure-compile-time.py --header UnitGuard.hpp --pch
+#   scripts/measure-compile-time.py --src-dir /path/to/old/checkout/src --header UnitGuard.hpp --prelude string tuple
+
+import argparse
+import os
+import shutil
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+TRANSLATION_UNIT = """{prelude}#include "{header}"
+
+namespace tu{index}
+{{
+using namespace UnitGuard;
+
+Pressure< double > kernel{index}( Length< double > l, Time< double > t, Mass< double > m )
+{{
+  auto v = l / t;
+  auto a = v / t;
+  return ( m * a ) / ( l * l );
+}}
+}}
+"""
+
+parser = argparse.ArgumentParser(description="Measure per-TU compile time of a UnitGuard header.")
+
+parser.add_argument("--header", type=str, default="UnitGuard.hpp", help="Header to include, relative to --src-dir.")
+parser.add_argument("--src-dir", type=str, default=os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src"),
+                    help="Directory holding the UnitGuard headers.")
+parser.add_argument("--count", type=int, default=200, help="Number of translation units.")
+parser.add_argument("--compiler", type=str, default=os.environ.get("CXX", "g++"), help="C++ compiler.")
+parser.add_argument("--flags", type=str, default="-std=c++17 -O2", help="Compiler flags.")
+parser.add_argument("--prelude", nargs="*", default=[],
+                    help="Standard headers to include before the header, for headers that are not self-contained.")
+parser.add_argument("--pch", action="store_true", help="Precompile the header once and force-include it in every TU.")
+parser.add_argument("--define", nargs="*", default=[], help="Preprocessor definitions, e.g. UNITGUARD_EXPLICIT_INSTANTIATION.")
+
+args = parser.parse_args()
+
+src_dir = os.path.abspath(args.src_dir)
+flags = args.flags.split() + ["-D" + d for d in args.define]
+work_dir = tempfile.mkdtemp(prefix="unitguard-compile-time-")
+
+try:
+    prelude = "".join("#include <%s>\n" % h for h in args.prelude)
+    include_flags = ["-I", src_dir]
+
+    if args.pch:
+        # GCC and Clang both pick up header.gch / header.pch next to a force-included header
+        pch_header = os.path.join(work_dir, "pch.hpp")
+        with open(pch_header, "w") as f:
+            f.write(prelude + '#include "%s"\n' % args.header)
+        suffix = ".gch" if "clang" not in os.path.basename(args.compiler) else ".pch"
+        subprocess.check_call([args.compiler] + flags + include_flags + ["-x", "c++-header", pch_header, "-o", pch_header + suffix])
+        include_flags += ["-include", pch_header]
+        prelude = ""
+
+    times = []
+    for i in range(args.count):
+        source = os.path.join(work_dir, "tu%d.cpp" % i)
+        with open(source, "w") as f:
+            f.write(TRANSLATION_UNIT.format(prelude=prelude, header=args.header, index=i))
+
+        start = time.perf_counter()
+        subprocess.check_call([args.compiler] + flags + include_flags + ["-c", source, "-o", source + ".o"])
+        times.append(time.perf_counter() - start)
+
+    print("header:   %s%s" % (args.header, " (pch)" if args.pch else ""))
+    print("TUs:      %d" % len(times))
+    print("mean:     %.1f ms" % (1000.0 * statistics.mean(times)))
+    print("median:   %.1f ms" % (1000.0 * statistics.median(times)))
+    print("total:    %.2f s" % sum(times))
+finally:
+    shutil.rmtree(work_dir)
+
+sys.exit(0)
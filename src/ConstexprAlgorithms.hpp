@@ -1,8 +1,18 @@
 #pragma once
 
+#include <type_traits>
+
 namespace UnitGuard
 {
 
+// IsConstantEvaluated -----------------------------------------------------------------------------
+
+/// True while evaluated as part of a constant expression, std::is_constant_evaluated() for C++17
+constexpr bool isConstantEvaluated()
+{
+  return __builtin_is_constant_evaluated();
+}
+
 // Prepend -----------------------------------------------------------------------------
 
 // Forward declaration
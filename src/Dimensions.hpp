@@ -0,0 +1,150 @@
+#pragma once
+
+#include "Unit.hpp"
+
+namespace UnitGuard
+{
+
+// --------------------------------------------
+// Fundamental tags for all atomic dimensions:
+struct MassTag        : public AtomTag {};
+struct LengthTag      : public AtomTag {};
+struct TimeTag        : public AtomTag {};
+struct CurrentTag     : public AtomTag {}; // e.g. electrice current
+struct TemperatureTag : public AtomTag {};
+struct AmmountTag     : public AtomTag {}; // e.g. moles
+struct LuminanceTag   : public AtomTag {}; // e.g. candelas
+
+
+// Establish canonical ordering
+template < >
+struct CanonicalOrder< MassTag >
+{
+  static constexpr int value = 0;
+};
+
+template < >
+struct CanonicalOrder< LengthTag >
+{
+  static constexpr int value = 1;
+};
+
+template < >
+struct CanonicalOrder< TimeTag >
+{
+  static constexpr int value = 2;
+};
+
+template < >
+struct CanonicalOrder< CurrentTag >
+{
+  static constexpr int value = 3;
+};
+
+
+template < >
+struct CanonicalOrder< TemperatureTag >
+{
+  static constexpr int value = 4;
+};
+
+template < >
+struct CanonicalOrder< AmmountTag >
+{
+  static constexpr int value = 5;
+};
+
+template < >
+struct CanonicalOrder< LuminanceTag >
+{
+  static constexpr int value = 6;
+};
+
+// --------------------------------------------
+// Dimensionless (no base units at all):
+using Dimensionless = Unit<>;
+
+// --------------------------------------------
+// Single-base (fundamental) units:
+using MassDimension        = Unit<Power<MassTag,         1>>;
+using LengthDimension      = Unit<Power<LengthTag,       1>>;
+using TimeDimension        = Unit<Power<TimeTag,         1>>;
+using CurrentDimension     = Unit<Power<CurrentTag,      1>>;
+using TemperatureDimension = Unit<Power<TemperatureTag,  1>>;
+using AmmountDimension     = Unit<Power<AmmountTag,      1>>;
+using LuminanceDimension   = Unit<Power<LuminanceTag,    1>>;
+
+// --------------------------------------------
+// Derived units:
+
+// Frequency = Time^-1
+using FrequencyDimension = Unit< Power< TimeTag, -1 > >;
+
+// Area = Length^2
+using AreaDimension = Unit< Power< LengthTag, 2 > >;
+
+// Volume = Length^3
+using VolumeDimension = Unit< Power< LengthTag, 3 > >;
+
+// Velocity = Length^1 * Time^-1
+using VelocityDimension = Unit<
+  Power< LengthTag, 1 >,
+  Power< TimeTag,  -1 >
+>;
+
+// Acceleration = Length^1 * Time^-2
+using AccelerationDimension = Unit<
+  Power< LengthTag, 1 >,
+  Power< TimeTag,  -2 >
+>;
+
+// Momentum = Mass^1 * Length^1 * Time^-1
+using MomentumDimension = Unit<
+  Power< MassTag,   1 >,
+  Power< LengthTag, 1 >,
+  Power< TimeTag,  -1 >
+>;
+
+// Force = Mass^1 * Length^1 * Time^-2
+using ForceDimension = Unit<
+  Power< MassTag,   1 >,
+  Power< LengthTag, 1 >,
+  Power< TimeTag,  -2 >
+>;
+
+// Pressure = Force / Area = Mass^1 * Length^-1 * Time^-2
+using PressureDimension = Unit<
+  Power< MassTag,   1 >,
+  Power< LengthTag, -1 >,
+  Power< TimeTag,  -2 >
+>;
+
+// Energy = Force * Distance = Mass^1 * Length^2 * Time^-2
+using EnergyDimension = Unit<
+  Power< MassTag,   1 >,
+  Power< LengthTag, 2 >,
+  Power< TimeTag,  -2 >
+>;
+
+// Power  = Energy / Time = Mass^1 * Length^2 * Time^-3
+using PowerDimension = Unit<
+  Power< MassTag,   1 >,
+  Power< LengthTag, 2 >,
+  Power< TimeTag,  -3 >
+>;
+
+// --------------------------------------------
+// thermodynamic-derived
+
+// Entropy = Energy / Temperature = Mass^1 * Length^2 * Time^-2 * Temperature^-1
+using EntropyDimension = Unit<
+  Power< MassTag,         1 >,
+  Power< LengthTag,       2 >,
+  Power< TimeTag,        -2 >,
+  Power< TemperatureTag, -1 >
+>;
+
+// HeatCapacity = Energy / Temperature (identical to Entropy dimensionally)
+using HeatCapacityDimension = EntropyDimension;
+
+}
\ No newline at end of file
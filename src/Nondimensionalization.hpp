@@ -0,0 +1,186 @@
+#pragma once
+
+#include "QuantitySpan.hpp"
+
+#include <stdexcept>
+
+namespace UnitGuard
+{
+
+/// base^exp for an integer exponent, usable in constant expressions
+constexpr double integerPower( double base, int exp )
+{
+  double result = 1.0;
+  double factor = exp < 0 ? 1.0 / base : base;
+  for( unsigned int e = static_cast< unsigned int >( exp < 0 ? -exp : exp ); e != 0; e >>= 1 )
+  {
+    if( e & 1u )
+    {
+      result *= factor;
+    }
+    factor *= factor;
+  }
+  return result;
+}
+
+/// Reference scale of one atomic dimension, e.g. ReferenceScale< LengthTag >{ 100.0 } for a 100 m reservoir
+template < typename Tag >
+struct ReferenceScale
+{
+  static_assert( std::is_base_of< AtomTag, Tag >::value, "ReferenceScale: Tag must inherit from AtomTag" );
+
+  using tag_type = Tag;
+  double value;
+};
+
+// ReferenceScales.hpp -----------------------------------------------------------------------------
+
+/// One reference scale per atomic dimension, atoms without a declared scale keep the SI scale of 1.
+/// The scale of any Unit is the product of its atom scales raised to the exponents in its Power pack,
+/// so with a constexpr ReferenceScales every factor< U >() folds to a constant.
+class ReferenceScales
+{
+public:
+  template < typename... Tags >
+  constexpr explicit ReferenceScales( ReferenceScale< Tags >... scales ):
+    m_scales { 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 }
+  {
+    static_assert( sizeof...( Tags ) <= numAtomDimensions, "ReferenceScales: more scales than atomic dimensions" );
+    ( ( m_scales[ CanonicalOrder< Tags >::value ] = scales.value ), ... );
+  }
+
+  /// Scale that maps a value of unit U onto its dimensionless counterpart
+  template < typename U >
+  constexpr double factor() const
+  {
+    DimensionVector const exponents = UnitExponents< U >::value;
+    double result = 1.0;
+    for( int i = 0; i < numAtomDimensions; ++i )
+    {
+      result *= integerPower( m_scales[ i ], exponents[ i ] );
+    }
+    return result;
+  }
+
+  /// Copy of these scales with the scale of Tag chosen so that factor< U >() == reference,
+  /// e.g. withDerived< MassTag, PressureDimension >( 1.0e7 ) for a reference pressure of 10 MPa
+  template < typename Tag, typename U >
+  constexpr ReferenceScales withDerived( double reference ) const
+  {
+    constexpr int rank = CanonicalOrder< Tag >::value;
+    constexpr int exponent = UnitExponents< U >::value[ rank ];
+    static_assert( exponent == 1 || exponent == -1, "ReferenceScales: U must contain Tag with exponent 1 or -1" );
+
+    ReferenceScales derived = *this;
+    derived.m_scales[ rank ] = 1.0;
+    derived.m_scales[ rank ] = integerPower( reference / derived.factor< U >(), exponent );
+    return derived;
+  }
+
+private:
+  double m_scales[ numAtomDimensions ];
+};
+
+// NondimensionalSpan.hpp -----------------------------------------------------------------------------
+
+/// Dimensionless working array that remembers the unit U of the field it was scaled from. Kernels use it as
+/// a QuantitySpan< T, Dimensionless >, and redimensionalize deduces U from it, so a working array can only be
+/// mapped back onto a field of the unit it came from. The constructors are explicit to make callers name U.
+template < typename T, typename U >
+class NondimensionalSpan;
+
+template < typename S >
+struct IsNondimensionalSpan : std::false_type {};
+
+template < typename T, typename U >
+struct IsNondimensionalSpan< NondimensionalSpan< T, U > > : std::true_type {};
+
+template < typename T, typename U >
+class NondimensionalSpan : public QuantitySpan< T, Dimensionless >
+{
+public:
+  using original_unit_type = U;
+
+  constexpr NondimensionalSpan() = default;
+
+  constexpr explicit NondimensionalSpan( typename QuantitySpan< T, Dimensionless >::element_type * data, std::size_t size ):
+    QuantitySpan< T, Dimensionless >( data, size )
+  {}
+
+  constexpr explicit NondimensionalSpan( QuantitySpan< T, Dimensionless > const span ):
+    QuantitySpan< T, Dimensionless >( span )
+  {}
+
+  /// View a contiguous container such as a std::vector< Quantity< T, Dimensionless > >. Not another
+  /// NondimensionalSpan, which would convert through its base and lose its unit.
+  template < typename Container,
+             typename = std::enable_if_t< !IsNondimensionalSpan< std::remove_const_t< Container > >::value &&
+                                          std::is_convertible< Container &, QuantitySpan< T, Dimensionless > >::value > >
+  constexpr explicit NondimensionalSpan( Container & container ):
+    QuantitySpan< T, Dimensionless >( container )
+  {}
+
+  /// A mutable span converts to a read-only one of the same original unit
+  template < typename _T, typename = std::enable_if_t< std::is_const< T >::value && std::is_same< const _T, T >::value > >
+  constexpr NondimensionalSpan( const NondimensionalSpan< _T, U > & other ):
+    QuantitySpan< T, Dimensionless >( other.data(), other.size() )
+  {}
+
+  /// Re-tagging a working array with another unit, e.g. through the QuantitySpan constructor, does not compile
+  template < typename _T, typename V, typename = std::enable_if_t< !std::is_same< V, U >::value > >
+  NondimensionalSpan( const NondimensionalSpan< _T, V > & other ) = delete;
+
+  constexpr NondimensionalSpan subspan( std::size_t offset, std::size_t count ) const
+  {
+    return NondimensionalSpan( QuantitySpan< T, Dimensionless >::subspan( offset, count ) );
+  }
+};
+
+// Kernels.hpp -----------------------------------------------------------------------------
+
+/// Scale a field of unit U into its dimensionless working array, one multiply per element
+template < typename TIn, typename TOut, typename U >
+void nondimensionalize( const ReferenceScales & scales,
+                        QuantitySpan< TIn, U > const in,
+                        NondimensionalSpan< TOut, U > const out )
+{
+  static_assert( !std::is_const< TOut >::value, "nondimensionalize: output span must be mutable" );
+  if( in.size() != out.size() )
+  {
+    throw std::invalid_argument( "nondimensionalize: input and output sizes differ" );
+  }
+
+  TOut const inverse = static_cast< TOut >( 1.0 / scales.factor< U >() );
+  const TIn * const src = in.values();
+  TOut * const dst = out.values();
+  std::size_t const size = in.size();
+  for( std::size_t i = 0; i < size; ++i )
+  {
+    dst[ i ] = src[ i ] * inverse;
+  }
+}
+
+/// Map a working array back onto a field of unit U, the inverse of nondimensionalize. U is deduced from both
+/// spans, so a working array scaled from one unit does not compile against a field of another.
+template < typename TIn, typename TOut, typename U >
+void redimensionalize( const ReferenceScales & scales,
+                       NondimensionalSpan< TIn, U > const in,
+                       QuantitySpan< TOut, U > const out )
+{
+  static_assert( !std::is_const< TOut >::value, "redimensionalize: output span must be mutable" );
+  if( in.size() != out.size() )
+  {
+    throw std::invalid_argument( "redimensionalize: input and output sizes differ" );
+  }
+
+  TOut const scale = static_cast< TOut >( scales.factor< U >() );
+  const TIn * const src = in.values();
+  TOut * const dst = out.values();
+  std::size_t const size = in.size();
+  for( std::size_t i = 0; i < size; ++i )
+  {
+    dst[ i ] = src[ i ] * scale;
+  }
+}
+
+}
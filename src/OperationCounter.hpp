@@ -0,0 +1,298 @@
+#pragma once
+
+#include "Unit.hpp"
+
+// Operation counting is an opt-in build mode (UNITGUARD_ENABLE_OPERATION_COUNTS), every translation unit
+// linked together must agree on it. When it is off this header defines nothing but a no-op macro.
+#if defined( UNITGUARD_ENABLE_OPERATION_COUNTS )
+
+#include "QuantityFormat.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace UnitGuard
+{
+
+/// Arithmetic operations of Quantity that are counted
+enum class Operation : int
+{
+  Add,
+  Subtract,
+  Multiply,
+  Divide,
+  AddAssign,
+  SubtractAssign
+};
+
+inline constexpr int numOperations = 6;
+
+inline const char * operationName( Operation op )
+{
+  static const char * const names[ numOperations ] = { "+", "-", "*", "/", "+=", "-=" };
+  return names[ static_cast< int >( op ) ];
+}
+
+using OperationCounts = std::array< std::uint64_t, numOperations >;
+
+/// Merged view of the counters of all threads
+struct OperationReport
+{
+  OperationCounts counts {};
+  /// Counts broken down by result dimension, only filled with UNITGUARD_ENABLE_OPERATION_COUNTS_PER_DIMENSION
+  std::vector< std::pair< std::string, OperationCounts > > perDimension;
+
+  std::uint64_t count( Operation op ) const
+  {
+    return counts[ static_cast< int >( op ) ];
+  }
+
+  std::uint64_t total() const
+  {
+    std::uint64_t sum = 0;
+    for( std::uint64_t const c : counts )
+    {
+      sum += c;
+    }
+    return sum;
+  }
+};
+
+inline std::ostream & operator<<( std::ostream & os, const OperationReport & report )
+{
+  auto printRow = [&os]( const std::string & label, const OperationCounts & counts )
+  {
+    os << label;
+    for( int op = 0; op < numOperations; ++op )
+    {
+      os << "  " << operationName( static_cast< Operation >( op ) ) << " " << counts[ op ];
+    }
+    os << "\n";
+  };
+  printRow( "total", report.counts );
+  for( const auto & dimension : report.perDimension )
+  {
+    printRow( "[" + dimension.first + "]", dimension.second );
+  }
+  return os;
+}
+
+// Counters.hpp -----------------------------------------------------------------------------
+
+/// Result dimensions beyond this many distinct ones are lumped into a last "other" bucket
+inline constexpr int maxCountedDimensions = 128;
+
+// One thread's counters. Only the owning thread writes them, so an increment is a relaxed load and store
+// rather than a read-modify-write, the atomics only make the concurrent reads in a report well defined.
+class ThreadOperationCounters
+{
+public:
+  ThreadOperationCounters();
+  ~ThreadOperationCounters();
+
+  ThreadOperationCounters( const ThreadOperationCounters & ) = delete;
+  ThreadOperationCounters & operator=( const ThreadOperationCounters & ) = delete;
+
+  void increment( Operation op )
+  {
+    bump( m_counts[ static_cast< int >( op ) ] );
+  }
+
+  void increment( int dimension, Operation op )
+  {
+    bump( m_dimensionCounts[ dimension * numOperations + static_cast< int >( op ) ] );
+  }
+
+  void accumulate( OperationReport & report ) const
+  {
+    for( int op = 0; op < numOperations; ++op )
+    {
+      report.counts[ op ] += m_counts[ op ].load( std::memory_order_relaxed );
+    }
+    for( std::size_t d = 0; d < report.perDimension.size(); ++d )
+    {
+      for( int op = 0; op < numOperations; ++op )
+      {
+        report.perDimension[ d ].second[ op ] += m_dimensionCounts[ d * numOperations + op ].load( std::memory_order_relaxed );
+      }
+    }
+  }
+
+  void reset()
+  {
+    for( std::atomic< std::uint64_t > & c : m_counts )
+    {
+      c.store( 0, std::memory_order_relaxed );
+    }
+    for( int i = 0; i < maxCountedDimensions * numOperations; ++i )
+    {
+      m_dimensionCounts[ i ].store( 0, std::memory_order_relaxed );
+    }
+  }
+
+private:
+  static void bump( std::atomic< std::uint64_t > & c )
+  {
+    c.store( c.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+  }
+
+  std::array< std::atomic< std::uint64_t >, numOperations > m_counts {};
+  std::unique_ptr< std::atomic< std::uint64_t >[] > m_dimensionCounts;
+};
+
+// Keeps track of the live per-thread counters, the counts of threads that have exited,
+// and the names of the result dimensions seen so far.
+class OperationCounterRegistry
+{
+public:
+  static OperationCounterRegistry & instance()
+  {
+    static OperationCounterRegistry registry;
+    return registry;
+  }
+
+  void attach( ThreadOperationCounters * counters )
+  {
+    std::lock_guard< std::mutex > lock( m_mutex );
+    m_live.push_back( counters );
+  }
+
+  void detach( ThreadOperationCounters * counters )
+  {
+    std::lock_guard< std::mutex > lock( m_mutex );
+    counters->accumulate( m_retired );
+    for( std::size_t i = 0; i < m_live.size(); ++i )
+    {
+      if( m_live[ i ] == counters )
+      {
+        m_live.erase( m_live.begin() + static_cast< std::ptrdiff_t >( i ) );
+        break;
+      }
+    }
+  }
+
+  int dimensionIndex( const DimensionVector & exponents )
+  {
+    std::string name = dimensionString( exponents );
+
+    std::lock_guard< std::mutex > lock( m_mutex );
+    for( std::size_t d = 0; d < m_retired.perDimension.size(); ++d )
+    {
+      if( m_retired.perDimension[ d ].first == name )
+      {
+        return static_cast< int >( d );
+      }
+    }
+    if( m_retired.perDimension.size() + 1 == maxCountedDimensions )
+    {
+      name = "other";
+    }
+    else if( m_retired.perDimension.size() + 1 > maxCountedDimensions )
+    {
+      return maxCountedDimensions - 1;
+    }
+    m_retired.perDimension.emplace_back( name, OperationCounts {} );
+    return static_cast< int >( m_retired.perDimension.size() ) - 1;
+  }
+
+  OperationReport collect()
+  {
+    std::lock_guard< std::mutex > lock( m_mutex );
+    OperationReport report = m_retired;
+    for( ThreadOperationCounters const * counters : m_live )
+    {
+      counters->accumulate( report );
+    }
+    return report;
+  }
+
+  void reset()
+  {
+    std::lock_guard< std::mutex > lock( m_mutex );
+    m_retired.counts = OperationCounts {};
+    for( auto & dimension : m_retired.perDimension )
+    {
+      dimension.second = OperationCounts {};
+    }
+    for( ThreadOperationCounters * counters : m_live )
+    {
+      counters->reset();
+    }
+  }
+
+private:
+  OperationCounterRegistry() = default;
+
+  std::mutex m_mutex;
+  std::vector< ThreadOperationCounters * > m_live;
+  // Counts of exited threads, its perDimension names double as the dimension index table
+  OperationReport m_retired;
+};
+
+inline ThreadOperationCounters::ThreadOperationCounters():
+  m_dimensionCounts( new std::atomic< std::uint64_t >[ maxCountedDimensions * numOperations ] )
+{
+  reset();
+  OperationCounterRegistry::instance().attach( this );
+}
+
+inline ThreadOperationCounters::~ThreadOperationCounters()
+{
+  OperationCounterRegistry::instance().detach( this );
+}
+
+inline ThreadOperationCounters & threadOperationCounters()
+{
+  thread_local ThreadOperationCounters counters;
+  return counters;
+}
+
+/// Slot of dimension U in the per-dimension breakdown, resolved once per unit type
+template < typename U >
+int dimensionIndex()
+{
+  static int const index = OperationCounterRegistry::instance().dimensionIndex( UnitExponents< U >::value );
+  return index;
+}
+
+/// Record one operation producing a result of dimension U on the calling thread
+template < typename U >
+inline void countOperation( Operation op )
+{
+  ThreadOperationCounters & counters = threadOperationCounters();
+  counters.increment( op );
+#if defined( UNITGUARD_ENABLE_OPERATION_COUNTS_PER_DIMENSION )
+  counters.increment( dimensionIndex< U >(), op );
+#endif
+}
+
+/// Merge the counters of all live and exited threads. Exact once the counting threads are quiescent.
+inline OperationReport collectOperationCounts()
+{
+  return OperationCounterRegistry::instance().collect();
+}
+
+/// Zero all counters, must not race with counted operations
+inline void resetOperationCounts()
+{
+  OperationCounterRegistry::instance().reset();
+}
+
+}
+
+// Operations folded at compile time are not counted
+#define UNITGUARD_COUNT_OPERATION( OP, U ) \
+  ( ::UnitGuard::isConstantEvaluated() ? void() : ::UnitGuard::countOperation< U >( ::UnitGuard::Operation::OP ) )
+
+#else
+
+#define UNITGUARD_COUNT_OPERATION( OP, U ) ( ( void ) 0 )
+
+#endif
@@ -1,6 +1,7 @@
 #pragma once
 
-#include "Unit.hpp"
+#include "Dimensions.hpp"
+#include "OperationCounter.hpp"
 
 namespace UnitGuard
 {
@@ -11,19 +12,13 @@ class Quantity
 {
 public:
   T value;
-  explicit Quantity( T v ) : value(v) {}
+  constexpr explicit Quantity( T v ) : value(v) {}
 
   // Convert to raw number
-  operator T() const { return value; }
-
-  // For printing
-  operator std::string() const
-  {
-    return std::to_string(value);
-  }
+  constexpr operator T() const { return value; }
 
   template < typename _U >
-  Quantity< T, U > & operator=( const Quantity< T, _U > & other )
+  constexpr Quantity< T, U > & operator=( const Quantity< T, _U > & other )
   {
     static_assert( are_same_units< U, _U >::value, "Cannot assign incompatible units" );
     value = other.value;
@@ -31,194 +26,55 @@ public:
   }
 
   template < typename _U >
-  Quantity< T, U > & operator+=( const Quantity< T, _U > & other )
+  constexpr Quantity< T, U > & operator+=( const Quantity< T, _U > & other )
   {
     static_assert( are_same_units< U, _U >::value, "Cannot add different units" );
+    UNITGUARD_COUNT_OPERATION( AddAssign, U );
     value += other.value;
     return *this;
   }
 
   template < typename _U >
-  Quantity< T, U > & operator-=( const Quantity< T, _U > & other )
+  constexpr Quantity< T, U > & operator-=( const Quantity< T, _U > & other )
   {
-    static_assert( are_same_units< U, U >::value, "Cannot subtract different units" );
+    static_assert( are_same_units< U, _U >::value, "Cannot subtract different units" );
+    UNITGUARD_COUNT_OPERATION( SubtractAssign, U );
     value -= other.value;
     return *this;
   }
 
-  Quantity< T, U > operator+( const Quantity & other ) const
+  constexpr Quantity< T, U > operator+( const Quantity & other ) const
   {
+    UNITGUARD_COUNT_OPERATION( Add, U );
     return Quantity< T, U >( value + other.value );
   }
 
-  Quantity< T, U > operator-( const Quantity & other ) const
+  constexpr Quantity< T, U > operator-( const Quantity & other ) const
   {
+    UNITGUARD_COUNT_OPERATION( Subtract, U );
     return Quantity< T, U >( value - other.value );
   }
 
-    // Multiply: results in new Unit with exponents added
+  // Multiply: results in new Unit with exponents added
   template< typename OU >
-  auto operator*( const Quantity< T, OU > & other ) const
+  constexpr auto operator*( const Quantity< T, OU > & other ) const
   {
     using ResultUnit = typename Multiply< U, OU >::type;
+    UNITGUARD_COUNT_OPERATION( Multiply, ResultUnit );
     return Quantity< T, ResultUnit >( value * other.value );
   }
 
   // Divide: results in new Unit with exponents subtracted
   template< typename OU >
-  auto operator/( const Quantity< T, OU > & other ) const
+  constexpr auto operator/( const Quantity< T, OU > & other ) const
   {
     using ResultUnit = typename Divide< U, OU >::type;
+    UNITGUARD_COUNT_OPERATION( Divide, ResultUnit );
     return Quantity< T, ResultUnit >( value / other.value );
   }
 };
-#else
-template < typename T, typename >
-using Quantity = T;
 #endif
 
-// --------------------------------------------
-// Fundamental tags for all atomic dimensions:
-struct MassTag        : public AtomTag {};
-struct LengthTag      : public AtomTag {};
-struct TimeTag        : public AtomTag {};
-struct CurrentTag     : public AtomTag {}; // e.g. electrice current
-struct TemperatureTag : public AtomTag {};
-struct AmmountTag     : public AtomTag {}; // e.g. moles
-struct LuminanceTag   : public AtomTag {}; // e.g. candelas
-
-
-// Establish canonical ordering
-template < >
-struct CanonicalOrder< MassTag >
-{
-  static constexpr int value = 0;
-};
-
-template < >
-struct CanonicalOrder< LengthTag >
-{
-  static constexpr int value = 1;
-};
-
-template < >
-struct CanonicalOrder< TimeTag >
-{
-  static constexpr int value = 2;
-};
-
-template < >
-struct CanonicalOrder< CurrentTag >
-{
-  static constexpr int value = 3;
-};
-
-
-template < >
-struct CanonicalOrder< TemperatureTag >
-{
-  static constexpr int value = 4;
-};
-
-template < >
-struct CanonicalOrder< AmmountTag >
-{
-  static constexpr int value = 5;
-};
-
-template < >
-struct CanonicalOrder< LuminanceTag >
-{
-  static constexpr int value = 6;
-};
-
-// --------------------------------------------
-// Dimensionless (no base units at all):
-using Dimensionless = Unit<>;
-
-// --------------------------------------------
-// Single-base (fundamental) units:
-using MassDimension        = Unit<Power<MassTag,         1>>;
-using LengthDimension      = Unit<Power<LengthTag,       1>>;
-using TimeDimension        = Unit<Power<TimeTag,         1>>;
-using CurrentDimension     = Unit<Power<CurrentTag,      1>>;
-using TemperatureDimension = Unit<Power<TemperatureTag,  1>>;
-using AmmountDimension     = Unit<Power<AmmountTag,      1>>;
-using LuminanceDimension   = Unit<Power<LuminanceTag,    1>>;
-
-// --------------------------------------------
-// Derived units:
-
-// Frequency = Time^-1
-using FrequencyDimension = Unit< Power< TimeTag, -1 > >;
-
-// Area = Length^2
-using AreaDimension = Unit< Power< LengthTag, 2 > >;
-
-// Volume = Length^3
-using VolumeDimension = Unit< Power< LengthTag, 3 > >;
-
-// Velocity = Length^1 * Time^-1
-using VelocityDimension = Unit<
-  Power< LengthTag, 1 >,
-  Power< TimeTag,  -1 >
->;
-
-// Acceleration = Length^1 * Time^-2
-using AccelerationDimension = Unit<
-  Power< LengthTag, 1 >,
-  Power< TimeTag,  -2 >
->;
-
-// Momentum = Mass^1 * Length^1 * Time^-1
-using MomentumDimension = Unit<
-  Power< MassTag,   1 >,
-  Power< LengthTag, 1 >,
-  Power< TimeTag,  -1 >
->;
-
-// Force = Mass^1 * Length^1 * Time^-2
-using ForceDimension = Unit<
-  Power< MassTag,   1 >,
-  Power< LengthTag, 1 >,
-  Power< TimeTag,  -2 >
->;
-
-// Pressure = Force / Area = Mass^1 * Length^-1 * Time^-2
-using PressureDimension = Unit<
-  Power< MassTag,   1 >,
-  Power< LengthTag, -1 >,
-  Power< TimeTag,  -2 >
->;
-
-// Energy = Force * Distance = Mass^1 * Length^2 * Time^-2
-using EnergyDimension = Unit<
-  Power< MassTag,   1 >,
-  Power< LengthTag, 2 >,
-  Power< TimeTag,  -2 >
->;
-
-// Power  = Energy / Time = Mass^1 * Length^2 * Time^-3
-using PowerDimension = Unit<
-  Power< MassTag,   1 >,
-  Power< LengthTag, 2 >,
-  Power< TimeTag,  -3 >
->;
-
-// --------------------------------------------
-// thermodynamic-derived
-
-// Entropy = Energy / Temperature = Mass^1 * Length^2 * Time^-2 * Temperature^-1
-using EntropyDimension = Unit<
-  Power< MassTag,         1 >,
-  Power< LengthTag,       2 >,
-  Power< TimeTag,        -2 >,
-  Power< TemperatureTag, -1 >
->;
-
-// HeatCapacity = Energy / Temperature (identical to Entropy dimensionally)
-using HeatCapacityDimension = EntropyDimension;
-
 // ----------------------------------------------------------------------------
 
 template < typename T > using Length      = Quantity< T, LengthDimension >;
@@ -239,4 +95,33 @@ template < typename T > using Entropy     = Quantity< T, EntropyDimension >;
 // Optionally also define dimensionless (which is sometimes handy):
 template < typename T > using Scalar      = Quantity< T, Dimensionless >;
 
+// ----------------------------------------------------------------------------
+// Dimensions whose Quantity< double, * > is explicitly instantiated in QuantityInstantiations.cpp
+
+#define UNITGUARD_FOR_EACH_COMMON_DIMENSION( MACRO ) \
+  MACRO( Dimensionless )                             \
+  MACRO( MassDimension )                             \
+  MACRO( LengthDimension )                           \
+  MACRO( TimeDimension )                             \
+  MACRO( TemperatureDimension )                      \
+  MACRO( FrequencyDimension )                        \
+  MACRO( AreaDimension )                             \
+  MACRO( VolumeDimension )                           \
+  MACRO( VelocityDimension )                         \
+  MACRO( AccelerationDimension )                     \
+  MACRO( MomentumDimension )                         \
+  MACRO( ForceDimension )                            \
+  MACRO( PressureDimension )                         \
+  MACRO( EnergyDimension )                           \
+  MACRO( PowerDimension )                            \
+  MACRO( EntropyDimension )
+
+// The compiled instantiations hold the operators without counting, so a TU that counts operations
+// instantiates its own instead of calling into them
+#if defined( UNITGUARD_EXPLICIT_INSTANTIATION ) && ! defined( DISABLE_UNITGUARD ) && ! defined( UNITGUARD_ENABLE_OPERATION_COUNTS )
+#define UNITGUARD_EXTERN_QUANTITY( DIMENSION ) extern template class Quantity< double, DIMENSION >;
+UNITGUARD_FOR_EACH_COMMON_DIMENSION( UNITGUARD_EXTERN_QUANTITY )
+#undef UNITGUARD_EXTERN_QUANTITY
+#endif
+
 }
\ No newline at end of file
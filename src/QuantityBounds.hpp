@@ -0,0 +1,178 @@
+#pragma once
+
+#include "QuantitySpan.hpp"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+// Bounds checking is a debug build mode (UNITGUARD_ENABLE_BOUNDS_CHECKS). Checks run in batch over whole
+// arrays after they are written, never per Quantity operation, and without the macro checkBounds is empty
+// and assignChecked / transformChecked are a plain copy / transform, so Quantity itself is unchanged.
+#if defined( UNITGUARD_ENABLE_BOUNDS_CHECKS )
+#include "QuantityFormat.hpp"
+#endif
+
+namespace UnitGuard
+{
+
+/// Physical range of the values of a dimension, unbounded by default.
+/// Specialize it for the canonical (Mass, Length, Time, ...) ordering of a Unit to constrain that dimension.
+template < typename U >
+struct DimensionBounds
+{
+  static constexpr double lower = -std::numeric_limits< double >::infinity();
+  static constexpr double upper = std::numeric_limits< double >::infinity();
+};
+
+/// Absolute temperature cannot be negative. Every Temp array is bounded below by 0 K, temperature differences
+/// included: writing dT = -300 K through transformChecked throws unless it is given an unbounded policy,
+/// e.g. transformChecked< DimensionBounds< Dimensionless > >( dT, ... ).
+template < >
+struct DimensionBounds< TemperatureDimension >
+{
+  static constexpr double lower = 0.0;
+  static constexpr double upper = std::numeric_limits< double >::infinity();
+};
+
+/// Fractions such as porosity or saturation. Not every Dimensionless value is one, so pass it explicitly,
+/// e.g. checkBounds< UnitIntervalBounds >( porosity )
+struct UnitIntervalBounds
+{
+  static constexpr double lower = 0.0;
+  static constexpr double upper = 1.0;
+};
+
+/// The explicit Bounds policy, or the DimensionBounds of U when Bounds is void
+template < typename Bounds, typename U >
+using BoundsPolicy = std::conditional_t< std::is_void< Bounds >::value, DimensionBounds< CanonicalUnit< U > >, Bounds >;
+
+template < typename Bounds >
+constexpr bool isBounded()
+{
+  return Bounds::lower > -std::numeric_limits< double >::infinity() || Bounds::upper < std::numeric_limits< double >::infinity();
+}
+
+/// True if every value is finite and lies in [Bounds::lower, Bounds::upper]. Branch-free: independent
+/// running min/max lanes that the compiler keeps in vector registers, one comparison at the end.
+template < typename Bounds, typename T, typename U >
+bool inBounds( QuantitySpan< T, U > const span )
+{
+  using Scalar = std::remove_const_t< T >;
+  constexpr int numLanes = 8;
+  Scalar const lower = static_cast< Scalar >( Bounds::lower );
+  Scalar const upper = static_cast< Scalar >( Bounds::upper );
+
+  const Scalar * const values = span.values();
+  std::size_t const size = span.size();
+
+  Scalar minimum[ numLanes ];
+  Scalar maximum[ numLanes ];
+  // x * 0 is NaN for NaN and infinite x, zero otherwise. The min/max lanes alone can drop a NaN.
+  Scalar nonFinite[ numLanes ];
+  for( int l = 0; l < numLanes; ++l )
+  {
+    minimum[ l ] = lower;
+    maximum[ l ] = upper;
+    nonFinite[ l ] = Scalar( 0 );
+  }
+
+  std::size_t i = 0;
+  for( ; i + numLanes <= size; i += numLanes )
+  {
+    for( int l = 0; l < numLanes; ++l )
+    {
+      Scalar const x = values[ i + l ];
+      minimum[ l ] = minimum[ l ] < x ? minimum[ l ] : x;
+      maximum[ l ] = maximum[ l ] > x ? maximum[ l ] : x;
+      nonFinite[ l ] += x * Scalar( 0 );
+    }
+  }
+
+  bool inside = true;
+  for( ; i < size; ++i )
+  {
+    inside &= values[ i ] >= lower && values[ i ] <= upper && values[ i ] * Scalar( 0 ) >= Scalar( 0 );
+  }
+  for( int l = 0; l < numLanes; ++l )
+  {
+    inside &= minimum[ l ] >= lower && maximum[ l ] <= upper && nonFinite[ l ] >= Scalar( 0 );
+  }
+  return inside;
+}
+
+/// Index of the first value that is not finite or outside the bounds, or size() if there is none
+template < typename Bounds, typename T, typename U >
+std::size_t findOutOfBounds( QuantitySpan< T, U > const span )
+{
+  using Scalar = std::remove_const_t< T >;
+  const Scalar * const values = span.values();
+  for( std::size_t i = 0; i < span.size(); ++i )
+  {
+    if( !std::isfinite( values[ i ] ) ||
+        !( values[ i ] >= static_cast< Scalar >( Bounds::lower ) && values[ i ] <= static_cast< Scalar >( Bounds::upper ) ) )
+    {
+      return i;
+    }
+  }
+  return span.size();
+}
+
+/// Throw std::out_of_range if a value of the span is not finite or outside its bounds.
+/// A no-op unless UNITGUARD_ENABLE_BOUNDS_CHECKS, and for dimensions without bounds.
+template < typename Bounds = void, typename T, typename U >
+void checkBounds( QuantitySpan< T, U > const span )
+{
+#if defined( UNITGUARD_ENABLE_BOUNDS_CHECKS )
+  using Policy = BoundsPolicy< Bounds, U >;
+  if constexpr( isBounded< Policy >() )
+  {
+    if( !inBounds< Policy >( span ) )
+    {
+      std::size_t const i = findOutOfBounds< Policy >( span );
+      throw std::out_of_range( "UnitGuard bounds check: value " + std::to_string( span.values()[ i ] ) +
+                               " at index " + std::to_string( i ) +
+                               " of a [" + dimensionString< U >() + "] array is outside [" +
+                               std::to_string( Policy::lower ) + ", " + std::to_string( Policy::upper ) + "]" );
+    }
+  }
+#else
+  ( void ) span;
+#endif
+}
+
+/// dst = src, then check dst
+template < typename Bounds = void, typename TOut, typename TIn, typename U >
+void assignChecked( QuantitySpan< TOut, U > const dst, QuantitySpan< TIn, U > const src )
+{
+  static_assert( !std::is_const< TOut >::value, "assignChecked: destination span must be mutable" );
+  if( dst.size() != src.size() )
+  {
+    throw std::invalid_argument( "assignChecked: source and destination sizes differ" );
+  }
+  const TIn * const in = src.values();
+  TOut * const out = dst.values();
+  for( std::size_t i = 0; i < dst.size(); ++i )
+  {
+    out[ i ] = in[ i ];
+  }
+  checkBounds< Bounds >( dst );
+}
+
+/// out[ i ] = f( inputs[ i ]... ) for every i, then check out. f works on Quantities, so it stays unit-checked.
+template < typename Bounds = void, typename TOut, typename U, typename FUNC, typename... SPANS >
+void transformChecked( QuantitySpan< TOut, U > const out, FUNC && f, SPANS const &... inputs )
+{
+  static_assert( !std::is_const< TOut >::value, "transformChecked: output span must be mutable" );
+  if( ( ( inputs.size() != out.size() ) || ... ) )
+  {
+    throw std::invalid_argument( "transformChecked: input and output sizes differ" );
+  }
+  for( std::size_t i = 0; i < out.size(); ++i )
+  {
+    out[ i ] = f( inputs[ i ]... );
+  }
+  checkBounds< Bounds >( out );
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Unit.hpp"
+
+#include <iosfwd>
+#include <string>
+
+namespace UnitGuard
+{
+
+/// Human readable form of a dimension, e.g. "M^1 L^-1 T^-2" for a pressure and "1" when dimensionless
+inline std::string dimensionString( const DimensionVector & exponents )
+{
+  static const char * const symbols[ numAtomDimensions ] = { "M", "L", "T", "I", "K", "N", "J" };
+
+  std::string name;
+  for( int i = 0; i < numAtomDimensions; ++i )
+  {
+    if( exponents[ i ] != 0 )
+    {
+      name += ( name.empty() ? "" : " " ) + std::string( symbols[ i ] ) + "^" + std::to_string( exponents[ i ] );
+    }
+  }
+  return name.empty() ? "1" : name;
+}
+
+template < typename U >
+std::string dimensionString()
+{
+  return dimensionString( UnitExponents< U >::value );
+}
+
+#if ! defined( DISABLE_UNITGUARD )
+// For printing, the value alone
+template < typename T, typename U >
+std::string to_string( const Quantity< T, U > & q )
+{
+  return std::to_string( q.value );
+}
+
+// For printing, the value followed by its dimension. Generic in the stream so that only <iosfwd> is needed
+// here, the caller already includes the stream header it prints to.
+template < typename T, typename U, typename CharT, typename Traits >
+std::basic_ostream< CharT, Traits > & operator<<( std::basic_ostream< CharT, Traits > & os, const Quantity< T, U > & q )
+{
+  return os << q.value << " [" << dimensionString< U >() << "]";
+}
+#endif
+
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+#include "Quantity.hpp"
+
+namespace UnitGuard
+{
+
+#if ! defined( DISABLE_UNITGUARD ) && ! defined( UNITGUARD_ENABLE_OPERATION_COUNTS )
+#define UNITGUARD_INSTANTIATE_QUANTITY( DIMENSION ) template class Quantity< double, DIMENSION >;
+UNITGUARD_FOR_EACH_COMMON_DIMENSION( UNITGUARD_INSTANTIATE_QUANTITY )
+#undef UNITGUARD_INSTANTIATE_QUANTITY
+#endif
+
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "Quantity.hpp"
+
+#include <cmath>
+
+// Unit-aware versions of the <cmath> functions used in physics kernels. Each returns a Quantity of
+// the correct unit instead of decaying through operator T(). At run time every function calls the
+// same standard function or expression as the raw code, so the generated instructions are unchanged;
+// where the standard allows it (abs, min, max, clamp, pow) the function is also constexpr so that
+// material constants fold at compile time.
+
+namespace UnitGuard
+{
+
+#if ! defined( DISABLE_UNITGUARD )
+
+template < typename T, typename U >
+constexpr Quantity< T, U > abs( const Quantity< T, U > & q )
+{
+  if( isConstantEvaluated() )
+  {
+    if constexpr( std::is_floating_point< T >::value )
+    {
+      // fabsl is exact for every floating type and, like std::abs, also clears the sign of -0 and -NaN
+      return Quantity< T, U >( static_cast< T >( __builtin_fabsl( q.value ) ) );
+    }
+    else
+    {
+      return Quantity< T, U >( q.value < T( 0 ) ? -q.value : q.value );
+    }
+  }
+  return Quantity< T, U >( std::abs( q.value ) );
+}
+
+// Same semantics as std::min / std::max / std::clamp, which are not used to keep <algorithm> out
+template < typename T, typename U, typename _U >
+constexpr Quantity< T, U > min( const Quantity< T, U > & a, const Quantity< T, _U > & b )
+{
+  static_assert( are_same_units< U, _U >::value, "min: arguments must have the same units" );
+  return Quantity< T, U >( b.value < a.value ? b.value : a.value );
+}
+
+template < typename T, typename U, typename _U >
+constexpr Quantity< T, U > max( const Quantity< T, U > & a, const Quantity< T, _U > & b )
+{
+  static_assert( are_same_units< U, _U >::value, "max: arguments must have the same units" );
+  return Quantity< T, U >( a.value < b.value ? b.value : a.value );
+}
+
+template < typename T, typename U, typename _UL, typename _UH >
+constexpr Quantity< T, U > clamp( const Quantity< T, U > & v, const Quantity< T, _UL > & lo, const Quantity< T, _UH > & hi )
+{
+  static_assert( are_same_units< U, _UL >::value && are_same_units< U, _UH >::value, "clamp: arguments must have the same units" );
+  return Quantity< T, U >( v.value < lo.value ? lo.value : ( hi.value < v.value ? hi.value : v.value ) );
+}
+
+/// q^N, the unit has all its exponents multiplied by N
+template < int N, typename T, typename U >
+constexpr Quantity< T, typename Raise< U, N >::type > pow( const Quantity< T, U > & q )
+{
+  T result = T( 1 );
+  for( int i = 0; i < ( N < 0 ? -N : N ); ++i )
+  {
+    result *= q.value;
+  }
+  return Quantity< T, typename Raise< U, N >::type >( N < 0 ? T( 1 ) / result : result );
+}
+
+template < typename T, typename U, typename _U >
+Quantity< T, U > hypot( const Quantity< T, U > & a, const Quantity< T, _U > & b )
+{
+  static_assert( are_same_units< U, _U >::value, "hypot: arguments must have the same units" );
+  return Quantity< T, U >( std::hypot( a.value, b.value ) );
+}
+
+template < typename T, typename U, typename _U1, typename _U2 >
+Quantity< T, U > hypot( const Quantity< T, U > & a, const Quantity< T, _U1 > & b, const Quantity< T, _U2 > & c )
+{
+  static_assert( are_same_units< U, _U1 >::value && are_same_units< U, _U2 >::value, "hypot: arguments must have the same units" );
+  return Quantity< T, U >( std::hypot( a.value, b.value, c.value ) );
+}
+
+/// a * b + c in one rounding, c must have the units of a * b
+template < typename T, typename Ua, typename Ub, typename Uc >
+Quantity< T, typename Multiply< Ua, Ub >::type > fma( const Quantity< T, Ua > & a, const Quantity< T, Ub > & b, const Quantity< T, Uc > & c )
+{
+  using ResultUnit = typename Multiply< Ua, Ub >::type;
+  static_assert( are_same_units< ResultUnit, Uc >::value, "fma: c must have the units of a * b" );
+  return Quantity< T, ResultUnit >( std::fma( a.value, b.value, c.value ) );
+}
+
+// Transcendental functions only make sense of dimensionless ratios, e.g. exp( -E / ( R * T ) )
+template < typename T, typename U >
+Quantity< T, Dimensionless > exp( const Quantity< T, U > & q )
+{
+  static_assert( are_same_units< U, Dimensionless >::value, "exp: argument must be dimensionless" );
+  return Quantity< T, Dimensionless >( std::exp( q.value ) );
+}
+
+template < typename T, typename U >
+Quantity< T, Dimensionless > log( const Quantity< T, U > & q )
+{
+  static_assert( are_same_units< U, Dimensionless >::value, "log: argument must be dimensionless" );
+  return Quantity< T, Dimensionless >( std::log( q.value ) );
+}
+
+#else
+
+// Quantity< T, U > is T, so kernels written against UnitGuard:: names keep compiling
+
+using std::abs;
+using std::hypot;
+using std::fma;
+using std::exp;
+using std::log;
+
+template < typename T >
+constexpr T min( const T & a, const T & b )
+{
+  return b < a ? b : a;
+}
+
+template < typename T >
+constexpr T max( const T & a, const T & b )
+{
+  return a < b ? b : a;
+}
+
+template < typename T >
+constexpr T clamp( const T & v, const T & lo, const T & hi )
+{
+  return v < lo ? lo : ( hi < v ? hi : v );
+}
+
+template < int N, typename T >
+constexpr T pow( const T & x )
+{
+  T result = T( 1 );
+  for( int i = 0; i < ( N < 0 ? -N : N ); ++i )
+  {
+    result *= x;
+  }
+  return N < 0 ? T( 1 ) / result : result;
+}
+
+#endif
+
+}
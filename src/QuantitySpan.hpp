@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Quantity.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace UnitGuard
+{
+
+/// Non-owning view of a contiguous array of Quantity< T, U >, use a const T for a read-only view.
+/// The unit is a parameter of the span itself, so kernels written against spans still know it
+/// when Quantity< T, U > collapses to T under DISABLE_UNITGUARD.
+template < typename T, typename U >
+class QuantitySpan
+{
+public:
+  using scalar_type = std::remove_const_t< T >;
+  using unit_type = U;
+  using value_type = Quantity< scalar_type, U >;
+  using element_type = std::conditional_t< std::is_const< T >::value, const value_type, value_type >;
+
+  constexpr QuantitySpan() = default;
+
+  constexpr QuantitySpan( element_type * data, std::size_t size ):
+    m_data( data ),
+    m_size( size )
+  {}
+
+  /// View a contiguous container such as a std::vector< Quantity< T, U > >
+  template < typename Container,
+             typename = std::enable_if_t< std::is_convertible< decltype( std::declval< Container & >().data() ), element_type * >::value > >
+  constexpr QuantitySpan( Container & container ):
+    QuantitySpan( container.data(), container.size() )
+  {}
+
+  /// A mutable span converts to a read-only one
+  template < typename _T, typename = std::enable_if_t< std::is_const< T >::value && std::is_same< const _T, T >::value > >
+  constexpr QuantitySpan( const QuantitySpan< _T, U > & other ):
+    QuantitySpan( other.data(), other.size() )
+  {}
+
+  constexpr element_type * data() const { return m_data; }
+  constexpr std::size_t size() const { return m_size; }
+  constexpr bool empty() const { return m_size == 0; }
+
+  constexpr element_type * begin() const { return m_data; }
+  constexpr element_type * end() const { return m_data + m_size; }
+
+  constexpr element_type & operator[]( std::size_t i ) const { return m_data[ i ]; }
+
+  constexpr QuantitySpan subspan( std::size_t offset, std::size_t count ) const
+  {
+    return QuantitySpan( m_data + offset, count );
+  }
+
+  /// The underlying scalars, for kernels that must see plain arrays to vectorize
+  T * values() const
+  {
+#if ! defined( DISABLE_UNITGUARD )
+    // Quantity is standard layout with its value as the only member, so the two are pointer-interconvertible
+    static_assert( std::is_standard_layout< value_type >::value && sizeof( value_type ) == sizeof( scalar_type ),
+                   "Quantity must be a layout-compatible wrapper of its scalar" );
+    return reinterpret_cast< T * >( m_data );
+#else
+    return m_data;
+#endif
+  }
+
+private:
+  element_type * m_data = nullptr;
+  std::size_t m_size = 0;
+};
+
+#if ! defined( DISABLE_UNITGUARD )
+template < typename T, typename U, typename Alloc, template < typename, typename > class Container >
+QuantitySpan( Container< Quantity< T, U >, Alloc > & ) -> QuantitySpan< T, U >;
+
+template < typename T, typename U, typename Alloc, template < typename, typename > class Container >
+QuantitySpan( const Container< Quantity< T, U >, Alloc > & ) -> QuantitySpan< const T, U >;
+#endif
+
+}
@@ -0,0 +1,421 @@
+#pragma once
+
+#include "QuantitySpan.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace UnitGuard
+{
+
+/// Chunk boundaries fall on multiples of a cache line so that no two threads write the same line
+inline constexpr std::size_t cacheLineSize = 64;
+
+/// Arrays shorter than this per chunk are not worth a task
+inline constexpr std::size_t minChunkSize = 2048;
+
+/// Chunks per thread, the slack that work stealing uses to balance uneven kernels
+inline constexpr std::size_t chunksPerThread = 4;
+
+// ThreadPool.hpp -----------------------------------------------------------------------------
+
+/// Fixed set of threads with one work queue each. A parallel operation deals its chunks out in contiguous
+/// blocks, thread t gets the t-th block, and owners pop from the back of their queue while idle threads
+/// steal from the front of the others. The calling thread takes part as thread 0 for as long as it waits,
+/// so ThreadPool( 1 ) runs everything inline and a kernel may itself start a parallel operation.
+class ThreadPool
+{
+public:
+  explicit ThreadPool( std::size_t numThreads = defaultNumThreads() ):
+    m_queues( numThreads )
+  {
+    if( numThreads == 0 )
+    {
+      throw std::invalid_argument( "ThreadPool: needs at least one thread" );
+    }
+    for( auto & queue : m_queues )
+    {
+      queue = std::make_unique< WorkQueue >();
+    }
+    m_workers.reserve( numThreads - 1 );
+    for( std::size_t i = 1; i < numThreads; ++i )
+    {
+      m_workers.emplace_back( [this, i] { workerLoop( i ); } );
+    }
+  }
+
+  ThreadPool( const ThreadPool & ) = delete;
+  ThreadPool & operator=( const ThreadPool & ) = delete;
+
+  ~ThreadPool()
+  {
+    {
+      std::lock_guard< std::mutex > lock( m_sleepMutex );
+      m_stop = true;
+    }
+    m_wake.notify_all();
+    for( auto & worker : m_workers )
+    {
+      worker.join();
+    }
+  }
+
+  static std::size_t defaultNumThreads()
+  {
+    std::size_t const hardware = std::thread::hardware_concurrency();
+    return hardware == 0 ? 1 : hardware;
+  }
+
+  /// Number of threads including the calling one
+  std::size_t numThreads() const { return m_queues.size(); }
+
+  /// Thread a chunk is dealt to, the same for every operation with the same number of chunks
+  std::size_t owner( std::size_t chunk, std::size_t numChunks ) const
+  {
+    return chunk * numThreads() / numChunks;
+  }
+
+  /// f( chunk ) for every chunk in [0, numChunks), returns once all are done and rethrows the first exception.
+  /// Pinned chunks are never stolen: each runs on its owner thread, which is what first-touch placement needs.
+  template < typename FUNC >
+  void forEachChunk( std::size_t numChunks, FUNC && f, bool pinned = false )
+  {
+    if( numChunks == 0 )
+    {
+      return;
+    }
+
+    TaskGroup group;
+    group.remaining.store( numChunks, std::memory_order_relaxed );
+    // Tasks hold a type-erased pointer to this wrapper, it outlives them since we wait for all of them below
+    auto call = [&f]( std::size_t chunk ) { f( chunk ); };
+    using Call = decltype( call );
+    void ( * const run )( void *, std::size_t ) = []( void * context, std::size_t chunk )
+    {
+      ( *static_cast< Call * >( context ) )( chunk );
+    };
+
+    std::size_t chunk = 0;
+    for( std::size_t t = 0; t < numThreads(); ++t )
+    {
+      WorkQueue & queue = *m_queues[ t ];
+      std::lock_guard< std::mutex > lock( queue.mutex );
+      for( ; chunk < numChunks && owner( chunk, numChunks ) == t; ++chunk )
+      {
+        Task const task { run, &call, chunk, &group };
+        if( pinned )
+        {
+          queue.pinned.push_back( task );
+          queue.numPinned.fetch_add( 1, std::memory_order_relaxed );
+        }
+        else
+        {
+          queue.tasks.push_back( task );
+          m_numStealable.fetch_add( 1, std::memory_order_relaxed );
+        }
+      }
+    }
+    {
+      // Pairs with the predicate in workerLoop so that no wake-up is lost
+      std::lock_guard< std::mutex > lock( m_sleepMutex );
+    }
+    m_wake.notify_all();
+
+    std::size_t const self = currentThreadIndex();
+    while( group.remaining.load( std::memory_order_acquire ) != 0 )
+    {
+      if( !runOne( self ) )
+      {
+        std::this_thread::yield();
+      }
+    }
+
+    if( group.error )
+    {
+      std::rethrow_exception( group.error );
+    }
+  }
+
+private:
+  struct TaskGroup
+  {
+    std::atomic< std::size_t > remaining { 0 };
+    std::atomic< bool > failed { false };
+    std::mutex mutex;
+    std::exception_ptr error;
+  };
+
+  struct Task
+  {
+    void ( * run )( void * context, std::size_t chunk );
+    void * context;
+    std::size_t chunk;
+    TaskGroup * group;
+  };
+
+  /// Each queue on its own cache lines, they are locked by different threads
+  struct alignas( cacheLineSize ) WorkQueue
+  {
+    std::mutex mutex;
+    std::deque< Task > tasks;
+    std::deque< Task > pinned;
+    std::atomic< std::size_t > numPinned { 0 };
+  };
+
+  /// Index of the calling thread in this pool, external threads count as thread 0
+  std::size_t currentThreadIndex() const
+  {
+    return t_pool == this ? t_index : 0;
+  }
+
+  bool runOne( std::size_t self )
+  {
+    Task task {};
+    if( popOwn( self, task ) || steal( self, task ) )
+    {
+      execute( task );
+      return true;
+    }
+    return false;
+  }
+
+  bool popOwn( std::size_t self, Task & task )
+  {
+    WorkQueue & queue = *m_queues[ self ];
+    std::lock_guard< std::mutex > lock( queue.mutex );
+    if( !queue.pinned.empty() )
+    {
+      task = queue.pinned.back();
+      queue.pinned.pop_back();
+      queue.numPinned.fetch_sub( 1, std::memory_order_relaxed );
+      return true;
+    }
+    if( !queue.tasks.empty() )
+    {
+      task = queue.tasks.back();
+      queue.tasks.pop_back();
+      m_numStealable.fetch_sub( 1, std::memory_order_relaxed );
+      return true;
+    }
+    return false;
+  }
+
+  bool steal( std::size_t self, Task & task )
+  {
+    for( std::size_t k = 1; k < numThreads() && m_numStealable.load( std::memory_order_relaxed ) != 0; ++k )
+    {
+      WorkQueue & queue = *m_queues[ ( self + k ) % numThreads() ];
+      std::lock_guard< std::mutex > lock( queue.mutex );
+      if( !queue.tasks.empty() )
+      {
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+        m_numStealable.fetch_sub( 1, std::memory_order_relaxed );
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static void execute( const Task & task )
+  {
+    TaskGroup & group = *task.group;
+    // Once a chunk has failed the rest are skipped, the operation is going to throw anyway
+    if( !group.failed.load( std::memory_order_relaxed ) )
+    {
+      try
+      {
+        task.run( task.context, task.chunk );
+      }
+      catch( ... )
+      {
+        std::lock_guard< std::mutex > lock( group.mutex );
+        if( !group.error )
+        {
+          group.error = std::current_exception();
+        }
+        group.failed.store( true, std::memory_order_relaxed );
+      }
+    }
+    // Release the chunk's writes to the thread waiting on the group
+    group.remaining.fetch_sub( 1, std::memory_order_acq_rel );
+  }
+
+  void workerLoop( std::size_t self )
+  {
+    t_pool = this;
+    t_index = self;
+    WorkQueue & own = *m_queues[ self ];
+    while( true )
+    {
+      if( runOne( self ) )
+      {
+        continue;
+      }
+
+      std::unique_lock< std::mutex > lock( m_sleepMutex );
+      m_wake.wait( lock, [this, &own]
+      {
+        return m_stop ||
+               m_numStealable.load( std::memory_order_relaxed ) != 0 ||
+               own.numPinned.load( std::memory_order_relaxed ) != 0;
+      } );
+      if( m_stop )
+      {
+        return;
+      }
+    }
+  }
+
+  std::vector< std::unique_ptr< WorkQueue > > m_queues;
+  std::vector< std::thread > m_workers;
+  std::atomic< std::size_t > m_numStealable { 0 };
+
+  std::mutex m_sleepMutex;
+  std::condition_variable m_wake;
+  bool m_stop = false;
+
+  static inline thread_local const ThreadPool * t_pool = nullptr;
+  static inline thread_local std::size_t t_index = 0;
+};
+
+// ChunkPartition.hpp -----------------------------------------------------------------------------
+
+/// Split of an array into contiguous chunks whose inner boundaries are cache line aligned in memory,
+/// so that threads writing neighbouring chunks never share a line. Depends only on the array and the
+/// number of chunks, so an initialization and the kernels after it see the same chunks.
+class ChunkPartition
+{
+public:
+  ChunkPartition( const volatile void * data, std::size_t size, std::size_t elementSize, std::size_t numChunks ):
+    m_size( size ),
+    m_numChunks( numChunks )
+  {
+    std::uintptr_t const address = reinterpret_cast< std::uintptr_t >( data );
+    if( elementSize != 0 && cacheLineSize % elementSize == 0 && address % elementSize == 0 )
+    {
+      m_elementsPerLine = cacheLineSize / elementSize;
+      m_offset = ( address % cacheLineSize ) / elementSize;
+    }
+  }
+
+  std::size_t size() const { return m_size; }
+  std::size_t numChunks() const { return m_numChunks; }
+
+  std::size_t begin( std::size_t chunk ) const
+  {
+    if( chunk == 0 )
+    {
+      return 0;
+    }
+    if( chunk >= m_numChunks )
+    {
+      return m_size;
+    }
+    // Even split, then back to the start of the cache line that holds it
+    std::size_t const even = chunk * m_size / m_numChunks;
+    std::size_t const line = ( even + m_offset ) / m_elementsPerLine * m_elementsPerLine;
+    return line < m_offset ? 0 : line - m_offset;
+  }
+
+  std::size_t end( std::size_t chunk ) const { return begin( chunk + 1 ); }
+
+  /// Chunks for an array of size elements on pool, at least minChunkSize elements each
+  static std::size_t numChunksFor( const ThreadPool & pool, std::size_t size )
+  {
+    std::size_t const bySize = ( size + minChunkSize - 1 ) / minChunkSize;
+    std::size_t const byThreads = pool.numThreads() == 1 ? 1 : pool.numThreads() * chunksPerThread;
+    return bySize < byThreads ? bySize : byThreads;
+  }
+
+private:
+  std::size_t m_size;
+  std::size_t m_numChunks;
+  std::size_t m_elementsPerLine = 1;
+  std::size_t m_offset = 0;
+};
+
+template < typename T, typename U >
+ChunkPartition makePartition( const ThreadPool & pool, QuantitySpan< T, U > const span )
+{
+  return ChunkPartition( span.data(), span.size(), sizeof( typename QuantitySpan< T, U >::value_type ),
+                         ChunkPartition::numChunksFor( pool, span.size() ) );
+}
+
+// ParallelKernels.hpp -----------------------------------------------------------------------------
+
+/// f( q ) for every Quantity q of span, in parallel over cache line aligned chunks
+template < typename T, typename U, typename FUNC >
+void parallelFor( ThreadPool & pool, QuantitySpan< T, U > const span, FUNC && f )
+{
+  ChunkPartition const partition = makePartition( pool, span );
+  auto body = [&]( std::size_t chunk )
+  {
+    std::size_t const end = partition.end( chunk );
+    for( std::size_t i = partition.begin( chunk ); i < end; ++i )
+    {
+      f( span[ i ] );
+    }
+  };
+  pool.forEachChunk( partition.numChunks(), body );
+}
+
+/// out[ i ] = f( inputs[ i ]... ) for every i, in parallel over cache line aligned chunks of out.
+/// f works on Quantities, so the kernel stays unit-checked.
+template < typename TOut, typename U, typename FUNC, typename... SPANS >
+void parallelTransform( ThreadPool & pool, QuantitySpan< TOut, U > const out, FUNC && f, SPANS const &... inputs )
+{
+  static_assert( !std::is_const< TOut >::value, "parallelTransform: output span must be mutable" );
+  if( ( ( inputs.size() != out.size() ) || ... ) )
+  {
+    throw std::invalid_argument( "parallelTransform: input and output sizes differ" );
+  }
+
+  ChunkPartition const partition = makePartition( pool, out );
+  auto body = [&]( std::size_t chunk )
+  {
+    std::size_t const end = partition.end( chunk );
+    for( std::size_t i = partition.begin( chunk ); i < end; ++i )
+    {
+      out[ i ] = f( inputs[ i ]... );
+    }
+  };
+  pool.forEachChunk( partition.numChunks(), body );
+}
+
+/// span[ i ] = f( i ) for every i, each chunk written by the thread that later kernels deal it to.
+/// Call it on freshly allocated memory: the OS places a page on the NUMA node of the thread that first
+/// writes it, so the pages of every chunk end up local to the thread that works on them.
+template < typename T, typename U, typename FUNC >
+void parallelInitialize( ThreadPool & pool, QuantitySpan< T, U > const span, FUNC && f )
+{
+  static_assert( !std::is_const< T >::value, "parallelInitialize: span must be mutable" );
+  ChunkPartition const partition = makePartition( pool, span );
+  auto body = [&]( std::size_t chunk )
+  {
+    std::size_t const end = partition.end( chunk );
+    for( std::size_t i = partition.begin( chunk ); i < end; ++i )
+    {
+      span[ i ] = f( i );
+    }
+  };
+  pool.forEachChunk( partition.numChunks(), body, true );
+}
+
+/// First-touch fill of span with value, see parallelInitialize
+template < typename T, typename U >
+void parallelFill( ThreadPool & pool, QuantitySpan< T, U > const span, typename QuantitySpan< T, U >::value_type const value )
+{
+  parallelInitialize( pool, span, [value]( std::size_t ) { return value; } );
+}
+
+}
\ No newline at end of file
@@ -1,13 +1,14 @@
 #pragma once
 
+#include "UnitGuardFwd.hpp"
 #include "ConstexprAlgorithms.hpp"
 
+#include <tuple>
+#include <type_traits>
+
 namespace UnitGuard
 {
 
-// unit tag struct for distinguishing atomic units
-struct AtomTag {};
-
 /// A Power is "Base^Exp", e.g. Length^1, Time^-1, etc.
 template< typename Base, int Exp >
 struct Power
@@ -18,7 +19,6 @@ struct Power
   static_assert( std::is_base_of< AtomTag, Base >::value, "Power: Base must inherit from AtomTag" );
 };
 
-// all Units we enforce compile-time constraints on are instantiations of "Unit", even non-composite units
 template< typename... Powers >
 struct Unit
 {
@@ -143,6 +143,56 @@ struct CanonicalUnitComparitor
 template < typename UnsortedUnit >
 using CanonicalUnit = typename SortPack< Unit, CanonicalUnitComparitor, UnsortedUnit >::type;
 
+// Exponents.hpp -----------------------------------------------------------------------------
+
+/// Number of atomic dimensions that can be ranked by CanonicalOrder< T >::value
+inline constexpr int numAtomDimensions = 7;
+
+/// Dense exponent vector indexed by CanonicalOrder, a constexpr-comparable stand-in for std::array
+struct DimensionVector
+{
+  int exponents[ numAtomDimensions ];
+
+  constexpr int & operator[]( int i ) { return exponents[ i ]; }
+  constexpr int operator[]( int i ) const { return exponents[ i ]; }
+
+  friend constexpr bool operator==( const DimensionVector & lhs, const DimensionVector & rhs )
+  {
+    for( int i = 0; i < numAtomDimensions; ++i )
+    {
+      if( lhs[ i ] != rhs[ i ] )
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  friend constexpr bool operator!=( const DimensionVector & lhs, const DimensionVector & rhs )
+  {
+    return !( lhs == rhs );
+  }
+};
+
+// Scatter each Power's exponent into the slot given by the rank of its base
+template < typename... Ps >
+constexpr DimensionVector denseExponents()
+{
+  DimensionVector exponents {};
+  ( ( exponents[ CanonicalOrder< typename Ps::base_type >::value ] += Ps::exponent ), ... );
+  return exponents;
+}
+
+/// UnitExponents< U > : dense exponent vector of a Unit<...>, indexed by CanonicalOrder
+template < typename U >
+struct UnitExponents;
+
+template < typename... Ps >
+struct UnitExponents< Unit< Ps... > >
+{
+  static constexpr DimensionVector value = denseExponents< Ps... >();
+};
+
 /// are_same_units< U1, U2> : check if two Unit<...> have the same (Base,Exp) pairs
 template < typename U1, typename U2 >
 struct are_same_units;
@@ -152,8 +202,8 @@ struct are_same_units< Unit< P1s... >, Unit< P2s... > >
 {
 private:
   // Sort both packs to canonical order
-  using CanonicalU1 = typename CanonicalUnit< Unit< P1s... > >::type;
-  using CanonicalU2 = typename CanonicalUnit<  Unit< P2s... > >::type;
+  using CanonicalU1 = CanonicalUnit< Unit< P1s... > >;
+  using CanonicalU2 = CanonicalUnit< Unit< P2s... > >;
 public:
   static constexpr bool value = std::is_same< CanonicalU1, CanonicalU2 >::value;
 };
@@ -181,4 +231,14 @@ struct Invert
   using type = typename Negate< U >::type;
 };
 
+/// Raise<U, N> -> every exponent multiplied by N
+template< typename U, int N >
+struct Raise;
+
+template< typename... Ps, int N >
+struct Raise< Unit< Ps... >, N >
+{
+  using type = std::conditional_t< N == 0, Unit< >, Unit< Power< typename Ps::base_type, Ps::exponent * N >... > >;
+};
+
 }
\ No newline at end of file
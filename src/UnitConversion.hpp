@@ -0,0 +1,215 @@
+#pragma once
+
+#include "Quantity.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace UnitGuard
+{
+
+// Runtime units -----------------------------------------------------------------------------
+
+/// Identity of a UnitDescriptor registered with a ConversionEngine, 0 is never handed out
+using UnitId = std::uint32_t;
+
+/// A unit known only at runtime (e.g. parsed from an input deck), as an affine map onto SI:
+/// si = scale * value + offset
+struct UnitDescriptor
+{
+  DimensionVector exponents;
+  double scale;
+  double offset;
+};
+
+/// Describe a runtime unit of dimension U, e.g. makeUnitDescriptor< PressureDimension >( 1.0e5 ) for bar
+template < typename U >
+constexpr UnitDescriptor makeUnitDescriptor( double scale = 1.0, double offset = 0.0 )
+{
+  return UnitDescriptor{ UnitExponents< U >::value, scale, offset };
+}
+
+/// Precomputed affine map between two runtime units: to = factor * from + offset
+struct ConversionFactor
+{
+  double factor;
+  double offset;
+
+  template < typename T >
+  T apply( T v ) const
+  {
+    return static_cast< T >( factor * v + offset );
+  }
+
+  template < typename T, typename U >
+  Quantity< T, U > apply( const Quantity< T, U > & q ) const
+  {
+    return Quantity< T, U >( apply( q.value ) );
+  }
+};
+
+// ConversionEngine.hpp -----------------------------------------------------------------------------
+
+/// Registry of runtime units plus a cache of conversion factors keyed by the packed (from, to) pair.
+/// Cache hits are lock-free: each slot publishes its key with release semantics after the factor is
+/// written, so readers that observe the key with acquire semantics also observe the factor.
+/// Misses and registrations serialize on a mutex.
+class ConversionEngine
+{
+public:
+  /// @param capacity number of (from, to) pairs to cache, pairs beyond it are recomputed on every lookup
+  explicit ConversionEngine( std::size_t capacity = 1024 )
+  {
+    std::size_t slots = 1;
+    while( slots < 2 * capacity )
+    {
+      slots *= 2;
+    }
+    m_mask = slots - 1;
+    m_capacity = slots / 2;
+    m_slots = std::make_unique< Slot[] >( slots );
+  }
+
+  ConversionEngine( const ConversionEngine & ) = delete;
+  ConversionEngine & operator=( const ConversionEngine & ) = delete;
+
+  UnitId registerUnit( const UnitDescriptor & unit )
+  {
+    if( !( unit.scale > 0.0 ) )
+    {
+      throw std::invalid_argument( "ConversionEngine: unit scale must be positive" );
+    }
+    std::lock_guard< std::mutex > lock( m_mutex );
+    m_units.push_back( unit );
+    return static_cast< UnitId >( m_units.size() );
+  }
+
+  template < typename U >
+  UnitId registerUnit( double scale = 1.0, double offset = 0.0 )
+  {
+    return registerUnit( makeUnitDescriptor< U >( scale, offset ) );
+  }
+
+  /// Factor and offset converting values in unit `from` to unit `to`, throws if the dimensions differ
+  ConversionFactor lookup( UnitId from, UnitId to )
+  {
+    return entry( from, to ).conversion;
+  }
+
+  /// Convert q from unit `from` to unit `to`, throws if the units are not of q's dimension U
+  template < typename T, typename U >
+  Quantity< T, U > convert( const Quantity< T, U > & q, UnitId from, UnitId to )
+  {
+    Entry const e = entry( from, to );
+    if( e.exponents != UnitExponents< U >::value )
+    {
+      throw std::invalid_argument( "ConversionEngine: unit ids do not match the dimension of the Quantity" );
+    }
+    return e.conversion.apply( q );
+  }
+
+  static constexpr std::uint64_t packKey( UnitId from, UnitId to )
+  {
+    return ( static_cast< std::uint64_t >( from ) << 32 ) | to;
+  }
+
+private:
+  static constexpr std::uint64_t emptyKey = 0;
+
+  /// A conversion with the dimension of both its units, cached so that convert never reads m_units unlocked
+  struct Entry
+  {
+    ConversionFactor conversion { 1.0, 0.0 };
+    DimensionVector exponents {};
+  };
+
+  struct Slot
+  {
+    std::atomic< std::uint64_t > key { emptyKey };
+    Entry entry;
+  };
+
+  Entry entry( UnitId from, UnitId to )
+  {
+    // Ids start at 1, so only ( 0, 0 ) packs to emptyKey and would match the first empty slot
+    if( from == 0 || to == 0 )
+    {
+      throw std::out_of_range( "ConversionEngine: unknown unit id" );
+    }
+    std::uint64_t const key = packKey( from, to );
+    for( std::size_t i = hash( key ), probes = 0; probes <= m_mask; i = ( i + 1 ) & m_mask, ++probes )
+    {
+      std::uint64_t const slotKey = m_slots[ i ].key.load( std::memory_order_acquire );
+      if( slotKey == key )
+      {
+        return m_slots[ i ].entry;
+      }
+      if( slotKey == emptyKey )
+      {
+        break;
+      }
+    }
+    return insert( key, from, to );
+  }
+
+  std::size_t hash( std::uint64_t key ) const
+  {
+    // Fibonacci hashing spreads the consecutive ids handed out by registerUnit
+    return static_cast< std::size_t >( ( key * 0x9E3779B97F4A7C15ull ) >> 32 ) & m_mask;
+  }
+
+  const UnitDescriptor & descriptor( UnitId id ) const
+  {
+    if( id == 0 || id > m_units.size() )
+    {
+      throw std::out_of_range( "ConversionEngine: unknown unit id" );
+    }
+    return m_units[ id - 1 ];
+  }
+
+  Entry insert( std::uint64_t key, UnitId from, UnitId to )
+  {
+    std::lock_guard< std::mutex > lock( m_mutex );
+
+    const UnitDescriptor & f = descriptor( from );
+    const UnitDescriptor & t = descriptor( to );
+    if( f.exponents != t.exponents )
+    {
+      throw std::invalid_argument( "ConversionEngine: cannot convert between units of different dimensions" );
+    }
+    Entry const e{ { f.scale / t.scale, ( f.offset - t.offset ) / t.scale }, f.exponents };
+
+    // Keep the table at most half full so probe sequences stay short and always hit an empty slot
+    if( m_size >= m_capacity )
+    {
+      return e;
+    }
+    std::size_t i = hash( key );
+    for( std::uint64_t slotKey; ( slotKey = m_slots[ i ].key.load( std::memory_order_relaxed ) ) != emptyKey; i = ( i + 1 ) & m_mask )
+    {
+      // Another thread inserted this pair while we waited for the lock
+      if( slotKey == key )
+      {
+        return m_slots[ i ].entry;
+      }
+    }
+    m_slots[ i ].entry = e;
+    m_slots[ i ].key.store( key, std::memory_order_release );
+    ++m_size;
+    return e;
+  }
+
+  std::unique_ptr< Slot[] > m_slots;
+  std::size_t m_mask = 0;
+  std::size_t m_capacity = 0;
+  std::size_t m_size = 0;
+  // deque keeps references stable while registerUnit appends
+  std::deque< UnitDescriptor > m_units;
+  std::mutex m_mutex;
+};
+
+}
@@ -0,0 +1,40 @@
+// C++20 module interface for UnitGuard, built when UNITGUARD_ENABLE_MODULE is ON.
+// Consumers `import unitguard;` instead of including UnitGuard.hpp. Macros such as
+// UNITGUARD_COUNT_OPERATION do not cross the module boundary, so build modes are fixed
+// when the module itself is compiled.
+
+module;
+
+// Every standard header UnitGuard uses is included here, in the global module fragment,
+// so that the includes inside the export block below are no-ops and the standard
+// library is not attached to this module.
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iosfwd>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+export module unitguard;
+
+// The opt-in headers too: they are parsed once when the module is built, not by every importer
+export
+{
+#include "UnitGuard.hpp"
+#include "QuantityMath.hpp"
+#include "QuantitySpan.hpp"
+#include "QuantityBounds.hpp"
+#include "Nondimensionalization.hpp"
+#include "UnitConversion.hpp"
+}
\ No newline at end of file
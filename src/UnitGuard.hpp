@@ -1,5 +1,10 @@
 #pragma once
 
+// Core of the library: the unit algebra, Quantity and its formatting. The heavier parts are opt-in headers
+// that a TU includes when it uses them: QuantityMath.hpp, QuantitySpan.hpp, QuantityBounds.hpp,
+// Nondimensionalization.hpp and UnitConversion.hpp, and ThreadPool.hpp through the unitguard_parallel target.
+
 #include "ConstexprAlgorithms.hpp"
 #include "Unit.hpp"
 #include "Quantity.hpp"
+#include "QuantityFormat.hpp"
\ No newline at end of file
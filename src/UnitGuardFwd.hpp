@@ -0,0 +1,38 @@
+#pragma once
+
+// Forward declarations of the UnitGuard vocabulary types, for headers that only pass them around
+
+namespace UnitGuard
+{
+
+// unit tag struct for distinguishing atomic units
+struct AtomTag {};
+
+template< typename Base, int Exp >
+struct Power;
+
+// all Units we enforce compile-time constraints on are instantiations of "Unit", even non-composite units
+template< typename... Powers >
+struct Unit;
+
+// Fundamental tags for all atomic dimensions, defined in Dimensions.hpp
+struct MassTag;
+struct LengthTag;
+struct TimeTag;
+struct CurrentTag;
+struct TemperatureTag;
+struct AmmountTag;
+struct LuminanceTag;
+
+#if ! defined( DISABLE_UNITGUARD )
+template < typename T, typename U >
+class Quantity;
+#else
+template < typename T, typename >
+using Quantity = T;
+#endif
+
+template < typename T, typename U >
+class QuantitySpan;
+
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+// Also set by the UNITGUARD_ENABLE_BOUNDS_CHECKS CMake option
+#if ! defined( UNITGUARD_ENABLE_BOUNDS_CHECKS )
+#define UNITGUARD_ENABLE_BOUNDS_CHECKS
+#endif
+
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "../QuantityBounds.hpp"
+
+using namespace UnitGuard;
+
+// Overhead of the bounds checking debug mode: a temperature update kernel with and without the batch
+// check of its output, and the check alone. Compare the Unchecked and Checked rows for the cost per value.
+
+namespace
+{
+
+struct Fields
+{
+  explicit Fields( std::size_t size )
+  {
+    for( std::size_t i = 0; i < size; ++i )
+    {
+      t.emplace_back( 273.15 + double( i % 97 ) );
+      dt.emplace_back( -0.5 + double( i % 89 ) / 89.0 );
+    }
+    out.resize( size, Temp< double >( 0.0 ) );
+  }
+
+  std::vector< Temp< double > > t;
+  std::vector< Temp< double > > dt;
+  std::vector< Temp< double > > out;
+};
+
+Temp< double > update( const Temp< double > & t, const Temp< double > & dt )
+{
+  return t + dt;
+}
+
+void BM_TransformUnchecked( benchmark::State & state )
+{
+  Fields fields( state.range( 0 ) );
+  QuantitySpan< double, TemperatureDimension > const out( fields.out );
+  QuantitySpan< const double, TemperatureDimension > const t( fields.t );
+  QuantitySpan< const double, TemperatureDimension > const dt( fields.dt );
+  for( auto _ : state )
+  {
+    for( std::size_t i = 0; i < out.size(); ++i )
+    {
+      out[ i ] = update( t[ i ], dt[ i ] );
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+
+void BM_TransformChecked( benchmark::State & state )
+{
+  Fields fields( state.range( 0 ) );
+  QuantitySpan< double, TemperatureDimension > const out( fields.out );
+  QuantitySpan< const double, TemperatureDimension > const t( fields.t );
+  QuantitySpan< const double, TemperatureDimension > const dt( fields.dt );
+  for( auto _ : state )
+  {
+    transformChecked( out, update, t, dt );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+
+void BM_CheckBounds( benchmark::State & state )
+{
+  Fields fields( state.range( 0 ) );
+  QuantitySpan< const double, TemperatureDimension > const t( fields.t );
+  for( auto _ : state )
+  {
+    benchmark::DoNotOptimize( inBounds< DimensionBounds< TemperatureDimension > >( t ) );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+
+}
+
+// From L1 resident to main memory sized arrays
+BENCHMARK( BM_TransformUnchecked )->RangeMultiplier( 16 )->Range( 1 << 10, 1 << 22 );
+BENCHMARK( BM_TransformChecked )->RangeMultiplier( 16 )->Range( 1 << 10, 1 << 22 );
+BENCHMARK( BM_CheckBounds )->RangeMultiplier( 16 )->Range( 1 << 10, 1 << 22 );
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+#include "../QuantityMath.hpp"
+
+using namespace UnitGuard;
+
+// Each unit-aware function against the raw call over the same data, the pairs should time identically
+
+namespace
+{
+
+constexpr std::size_t size = 1 << 14;
+
+struct Fields
+{
+  Fields()
+  {
+    for( std::size_t i = 0; i < size; ++i )
+    {
+      a.emplace_back( 0.5 + double( i % 97 ) / 97.0 );
+      b.emplace_back( -0.5 + double( i % 89 ) / 89.0 );
+    }
+  }
+
+  std::vector< Length< double > > a;
+  std::vector< Length< double > > b;
+  std::vector< double > out = std::vector< double >( size );
+};
+
+template < typename KERNEL >
+void run( benchmark::State & state, KERNEL && kernel )
+{
+  Fields fields;
+  const double * const a = &fields.a[ 0 ].value;
+  const double * const b = &fields.b[ 0 ].value;
+  for( auto _ : state )
+  {
+    for( std::size_t i = 0; i < size; ++i )
+    {
+      fields.out[ i ] = kernel( a[ i ], b[ i ] );
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * size );
+}
+
+}
+
+#define UNITGUARD_MATH_BENCHMARK( NAME, RAW, UNIT )                                                       \
+  static void BM_##NAME##_Raw( benchmark::State & state )                                                 \
+  {                                                                                                        \
+    run( state, []( double x, double y ) { (void) x; (void) y; return RAW; } );                                      \
+  }                                                                                                        \
+  BENCHMARK( BM_##NAME##_Raw );                                                                            \
+  static void BM_##NAME##_Quantity( benchmark::State & state )                                            \
+  {                                                                                                        \
+    run( state, []( double xv, double yv ) { Length< double > x( xv ), y( yv ); (void) x; (void) y; return static_cast< double >( UNIT ); } ); \
+  }                                                                                                        \
+  BENCHMARK( BM_##NAME##_Quantity )
+
+UNITGUARD_MATH_BENCHMARK( Abs, std::abs( y ), abs( y ) );
+UNITGUARD_MATH_BENCHMARK( Min, y < x ? y : x, min( x, y ) );
+UNITGUARD_MATH_BENCHMARK( Clamp, y < 0.0 ? 0.0 : ( x < y ? x : y ), clamp( y, Length< double >( 0.0 ), x ) );
+UNITGUARD_MATH_BENCHMARK( Pow3, x * x * x, pow< 3 >( x ) );
+UNITGUARD_MATH_BENCHMARK( Hypot, std::hypot( x, y ), hypot( x, y ) );
+UNITGUARD_MATH_BENCHMARK( Fma, std::fma( x, y, x * x ), fma( x, y, x * x ) );
+UNITGUARD_MATH_BENCHMARK( Exp, std::exp( y / x ), exp( y / x ) );
+UNITGUARD_MATH_BENCHMARK( Log, std::log( x / ( x + x ) ), log( x / ( x + x ) ) );
+
+BENCHMARK_MAIN();
@@ -0,0 +1,153 @@
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "../QuantityMath.hpp"
+#include "../ThreadPool.hpp"
+
+using namespace UnitGuard;
+
+// Strong scaling of parallelTransform from 1 thread to all hardware threads, for a memory bound and a
+// compute bound kernel, against the serial loop. The FirstTouch pair runs the same memory bound kernel
+// on arrays initialized serially or with parallelFill, the gap is the NUMA placement on multi-socket nodes.
+// Single runs of the serial and 1-thread rows differ by more than their gap, compare them with
+// --benchmark_repetitions=10 --benchmark_enable_random_interleaving=true
+
+namespace
+{
+
+constexpr std::size_t size = 1 << 22;
+
+void threadCounts( benchmark::internal::Benchmark * benchmark )
+{
+  int const hardware = static_cast< int >( ThreadPool::defaultNumThreads() );
+  for( int t = 1; t < hardware; t *= 2 )
+  {
+    benchmark->Arg( t );
+  }
+  benchmark->Arg( hardware );
+}
+
+// Lambdas rather than functions, a function pointer would be an indirect call per element inside the chunks
+auto const stream = []( const Length< double > & l, const Time< double > & t )
+{
+  return l / t;
+};
+
+auto const arrhenius = []( const Frequency< double > & a, const Temp< double > & t )
+{
+  return a * exp( Temp< double >( -3000.0 ) / t );
+};
+
+/// Uninitialized storage, so that the pages are first touched by the initialization under test
+template < typename U >
+struct Storage
+{
+  Storage():
+    data( static_cast< Quantity< double, U > * >( std::malloc( size * sizeof( Quantity< double, U > ) ) ) )
+  {}
+
+  ~Storage() { std::free( data ); }
+
+  Storage( const Storage & ) = delete;
+  Storage & operator=( const Storage & ) = delete;
+
+  QuantitySpan< double, U > span() const { return QuantitySpan< double, U >( data, size ); }
+
+  Quantity< double, U > * const data;
+};
+
+template < typename U >
+void serialFill( Storage< U > & storage, Quantity< double, U > const value )
+{
+  for( std::size_t i = 0; i < size; ++i )
+  {
+    storage.data[ i ] = value;
+  }
+}
+
+void BM_StreamSerial( benchmark::State & state )
+{
+  Storage< LengthDimension > l;
+  Storage< TimeDimension > t;
+  Storage< VelocityDimension > v;
+  serialFill( l, Length< double >( 1.0 ) );
+  serialFill( t, Time< double >( 2.0 ) );
+  serialFill( v, Velocity< double >( 0.0 ) );
+  for( auto _ : state )
+  {
+    for( std::size_t i = 0; i < size; ++i )
+    {
+      v.data[ i ] = stream( l.data[ i ], t.data[ i ] );
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * size );
+}
+
+template < bool FIRST_TOUCH >
+void BM_Stream( benchmark::State & state )
+{
+  ThreadPool pool( state.range( 0 ) );
+  Storage< LengthDimension > l;
+  Storage< TimeDimension > t;
+  Storage< VelocityDimension > v;
+  if( FIRST_TOUCH )
+  {
+    parallelFill( pool, l.span(), Length< double >( 1.0 ) );
+    parallelFill( pool, t.span(), Time< double >( 2.0 ) );
+    parallelFill( pool, v.span(), Velocity< double >( 0.0 ) );
+  }
+  else
+  {
+    serialFill( l, Length< double >( 1.0 ) );
+    serialFill( t, Time< double >( 2.0 ) );
+    serialFill( v, Velocity< double >( 0.0 ) );
+  }
+  for( auto _ : state )
+  {
+    parallelTransform( pool, v.span(), stream, l.span(), t.span() );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * size );
+}
+
+void BM_ArrheniusSerial( benchmark::State & state )
+{
+  std::vector< Frequency< double > > a( size, Frequency< double >( 1.0e13 ) );
+  std::vector< Temp< double > > t( size, Temp< double >( 600.0 ) );
+  std::vector< Frequency< double > > rate( size, Frequency< double >( 0.0 ) );
+  for( auto _ : state )
+  {
+    for( std::size_t i = 0; i < size; ++i )
+    {
+      rate[ i ] = arrhenius( a[ i ], t[ i ] );
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * size );
+}
+
+void BM_Arrhenius( benchmark::State & state )
+{
+  ThreadPool pool( state.range( 0 ) );
+  std::vector< Frequency< double > > a( size, Frequency< double >( 1.0e13 ) );
+  std::vector< Temp< double > > t( size, Temp< double >( 600.0 ) );
+  std::vector< Frequency< double > > rate( size, Frequency< double >( 0.0 ) );
+  for( auto _ : state )
+  {
+    parallelTransform( pool, QuantitySpan( rate ), arrhenius, QuantitySpan( a ), QuantitySpan( t ) );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * size );
+}
+
+}
+
+BENCHMARK( BM_StreamSerial )->UseRealTime();
+BENCHMARK_TEMPLATE( BM_Stream, false )->Name( "BM_StreamAfterSerialInit" )->Apply( threadCounts )->UseRealTime();
+BENCHMARK_TEMPLATE( BM_Stream, true )->Name( "BM_StreamAfterFirstTouch" )->Apply( threadCounts )->UseRealTime();
+BENCHMARK( BM_ArrheniusSerial )->UseRealTime();
+BENCHMARK( BM_Arrhenius )->Apply( threadCounts )->UseRealTime();
+
+BENCHMARK_MAIN();
\ No newline at end of file
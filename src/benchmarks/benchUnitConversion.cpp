@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "../UnitConversion.hpp"
+
+using namespace UnitGuard;
+
+namespace
+{
+
+// A handful of pressure units as they would come out of an input deck
+struct PressureUnits
+{
+  PressureUnits()
+  {
+    for( double scale : { 1.0, 1.0e3, 1.0e5, 1.0e6, 6894.757, 101325.0, 133.322, 47.88 } )
+    {
+      ids.push_back( engine.registerUnit< PressureDimension >( scale ) );
+    }
+    // Warm the cache so the benchmark measures the lock-free hit path
+    for( UnitId from : ids )
+    {
+      for( UnitId to : ids )
+      {
+        engine.lookup( from, to );
+      }
+    }
+  }
+
+  ConversionEngine engine;
+  std::vector< UnitId > ids;
+};
+
+PressureUnits & pressureUnits()
+{
+  static PressureUnits units;
+  return units;
+}
+
+}
+
+// Cached lookups from 1 thread up to the hardware concurrency, time per lookup should stay flat
+static void BM_ConversionLookup( benchmark::State & state )
+{
+  PressureUnits & units = pressureUnits();
+  std::size_t const n = units.ids.size();
+  std::size_t i = static_cast< std::size_t >( state.thread_index() );
+  for( auto _ : state )
+  {
+    ConversionFactor const c = units.engine.lookup( units.ids[ i % n ], units.ids[ ( i / n ) % n ] );
+    benchmark::DoNotOptimize( c );
+    ++i;
+  }
+  state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_ConversionLookup )->ThreadRange( 1, 64 )->UseRealTime();
+
+// Reference point: the same lookups serialized on a mutex
+static void BM_ConversionLookupLocked( benchmark::State & state )
+{
+  static std::mutex mutex;
+  PressureUnits & units = pressureUnits();
+  std::size_t const n = units.ids.size();
+  std::size_t i = static_cast< std::size_t >( state.thread_index() );
+  for( auto _ : state )
+  {
+    std::lock_guard< std::mutex > lock( mutex );
+    ConversionFactor const c = units.engine.lookup( units.ids[ i % n ], units.ids[ ( i / n ) % n ] );
+    benchmark::DoNotOptimize( c );
+    ++i;
+  }
+  state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK( BM_ConversionLookupLocked )->ThreadRange( 1, 64 )->UseRealTime();
+
+// Converting a whole field with a factor looked up once
+static void BM_ConvertField( benchmark::State & state )
+{
+  PressureUnits & units = pressureUnits();
+  std::size_t const size = static_cast< std::size_t >( state.range( 0 ) );
+  std::vector< Pressure< double > > const deck( size, Pressure< double >( 1.0 ) );
+  std::vector< Pressure< double > > si( size, Pressure< double >( 0.0 ) );
+  for( auto _ : state )
+  {
+    ConversionFactor const c = units.engine.lookup( units.ids[ 2 ], units.ids[ 0 ] );
+    for( std::size_t i = 0; i < size; ++i )
+    {
+      si[ i ] = c.apply( deck[ i ] );
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( BM_ConvertField )->Range( 1 << 10, 1 << 20 );
+
+BENCHMARK_MAIN();
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <type_traits>
+#include <vector>
+#include "../Nondimensionalization.hpp"
+
+using namespace UnitGuard;
+
+namespace
+{
+
+template < typename IN, typename OUT, typename = void >
+struct CanNondimensionalize : std::false_type {};
+
+template < typename IN, typename OUT >
+struct CanNondimensionalize< IN, OUT, std::void_t< decltype( nondimensionalize( std::declval< const ReferenceScales & >(), std::declval< IN >(), std::declval< OUT >() ) ) > > : std::true_type {};
+
+template < typename IN, typename OUT, typename = void >
+struct CanRedimensionalize : std::false_type {};
+
+template < typename IN, typename OUT >
+struct CanRedimensionalize< IN, OUT, std::void_t< decltype( redimensionalize( std::declval< const ReferenceScales & >(), std::declval< IN >(), std::declval< OUT >() ) ) > > : std::true_type {};
+
+}
+
+TEST( NondimensionalizationTests, IntegerPower )
+{
+  constexpr double zero = integerPower( 2.0, 0 );
+  constexpr double positive = integerPower( 2.0, 10 );
+  constexpr double negative = integerPower( 2.0, -3 );
+  EXPECT_DOUBLE_EQ( zero, 1.0 );
+  EXPECT_DOUBLE_EQ( positive, 1024.0 );
+  EXPECT_DOUBLE_EQ( negative, 0.125 );
+  EXPECT_DOUBLE_EQ( integerPower( 10.0, 7 ), 1.0e7 );
+}
+
+TEST( NondimensionalizationTests, CompileTimeFactors )
+{
+  constexpr ReferenceScales scales( ReferenceScale< LengthTag >{ 4.0 }, ReferenceScale< TimeTag >{ 2.0 }, ReferenceScale< MassTag >{ 8.0 } );
+
+  // Folded at compile time from the exponents of each Unit's Power pack
+  constexpr double dimensionless = scales.factor< Dimensionless >();
+  constexpr double length = scales.factor< LengthDimension >();
+  constexpr double velocity = scales.factor< VelocityDimension >();
+  constexpr double pressure = scales.factor< PressureDimension >();
+  constexpr double temperature = scales.factor< TemperatureDimension >();
+  EXPECT_DOUBLE_EQ( dimensionless, 1.0 );
+  EXPECT_DOUBLE_EQ( length, 4.0 );
+  EXPECT_DOUBLE_EQ( velocity, 2.0 );
+  EXPECT_DOUBLE_EQ( pressure, 8.0 / 4.0 / 4.0 );
+  // Undeclared atoms keep the SI scale
+  EXPECT_DOUBLE_EQ( temperature, 1.0 );
+
+  // A reference pressure fixes the mass scale given the length and time scales
+  constexpr ReferenceScales derived = ReferenceScales( ReferenceScale< LengthTag >{ 4.0 }, ReferenceScale< TimeTag >{ 2.0 } )
+                                        .withDerived< MassTag, PressureDimension >( 0.5 );
+  constexpr double derivedPressure = derived.factor< PressureDimension >();
+  constexpr double derivedMass = derived.factor< MassDimension >();
+  EXPECT_DOUBLE_EQ( derivedPressure, 0.5 );
+  // Mass scale = P L T^2
+  EXPECT_DOUBLE_EQ( derivedMass, 8.0 );
+}
+
+TEST( NondimensionalizationTests, RoundTrip )
+{
+  constexpr ReferenceScales scales = ReferenceScales( ReferenceScale< LengthTag >{ 100.0 }, ReferenceScale< TimeTag >{ 86400.0 } )
+                                       .withDerived< MassTag, PressureDimension >( 1.0e7 );
+
+  std::size_t const size = 1000;
+  std::vector< Pressure< double > > pressure;
+  for( std::size_t i = 0; i < size; ++i )
+  {
+    pressure.emplace_back( 1.0e7 + 1.0e3 * double( i ) );
+  }
+
+  std::vector< Scalar< double > > work( size, Scalar< double >( 0.0 ) );
+  NondimensionalSpan< double, PressureDimension > const workSpan( work );
+  nondimensionalize( scales, QuantitySpan( pressure ), workSpan );
+  EXPECT_DOUBLE_EQ( static_cast< double >( work[ 0 ] ), 1.0 );
+  EXPECT_DOUBLE_EQ( static_cast< double >( work[ 10 ] ), 1.001 );
+
+  // The working array remembers it holds a pressure, the way back applies the inverse pressure factor
+  std::vector< Pressure< double > > back( size, Pressure< double >( 0.0 ) );
+  redimensionalize( scales, workSpan, QuantitySpan( back ) );
+  for( std::size_t i = 0; i < size; ++i )
+  {
+    EXPECT_DOUBLE_EQ( static_cast< double >( back[ i ] ), static_cast< double >( pressure[ i ] ) );
+  }
+
+  std::vector< Scalar< double > > shorter( size - 1, Scalar< double >( 0.0 ) );
+  EXPECT_THROW( nondimensionalize( scales, QuantitySpan( pressure ), NondimensionalSpan< double, PressureDimension >( shorter ) ),
+                std::invalid_argument );
+}
+
+TEST( NondimensionalizationTests, MismatchedUnitsDoNotCompile )
+{
+  using PressureField = QuantitySpan< double, PressureDimension >;
+  using LengthField = QuantitySpan< double, LengthDimension >;
+  using PressureWork = NondimensionalSpan< double, PressureDimension >;
+  using LengthWork = NondimensionalSpan< double, LengthDimension >;
+
+  static_assert( CanNondimensionalize< PressureField, PressureWork >::value, "Same unit" );
+  static_assert( !CanNondimensionalize< PressureField, LengthWork >::value, "Pressure field into a length working array" );
+  static_assert( !CanNondimensionalize< PressureField, QuantitySpan< double, Dimensionless > >::value, "Working array without its unit" );
+
+  static_assert( CanRedimensionalize< PressureWork, PressureField >::value, "Same unit" );
+  static_assert( CanRedimensionalize< NondimensionalSpan< const double, PressureDimension >, PressureField >::value, "Read-only working array" );
+  static_assert( !CanRedimensionalize< PressureWork, LengthField >::value, "Pressure working array onto a length field" );
+  static_assert( !CanRedimensionalize< QuantitySpan< double, Dimensionless >, LengthField >::value, "Working array without its unit" );
+
+  // The working array is still a dimensionless span for the kernels in between
+  static_assert( std::is_convertible< PressureWork, QuantitySpan< double, Dimensionless > >::value, "Usable as a dimensionless span" );
+  static_assert( !std::is_convertible< QuantitySpan< double, Dimensionless >, PressureWork >::value, "The unit must be named" );
+
+  // Nor can a working array be re-tagged with another unit
+  static_assert( !std::is_constructible< LengthWork, PressureWork & >::value, "Pressure working array as a length one" );
+  static_assert( !std::is_constructible< LengthWork, const PressureWork & >::value, "Pressure working array as a length one" );
+  static_assert( !std::is_constructible< NondimensionalSpan< const double, LengthDimension >, PressureWork & >::value, "Read-only re-tag" );
+  static_assert( std::is_constructible< PressureWork, PressureWork & >::value, "Copy" );
+  static_assert( std::is_convertible< PressureWork, NondimensionalSpan< const double, PressureDimension > >::value, "Read-only view" );
+}
+
+int main( int argc, char ** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,127 @@
+#define UNITGUARD_ENABLE_OPERATION_COUNTS
+#define UNITGUARD_ENABLE_OPERATION_COUNTS_PER_DIMENSION
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "../OperationCounter.hpp"
+#include "../Quantity.hpp"
+
+using namespace UnitGuard;
+
+namespace
+{
+
+OperationCounts const * findDimension( const OperationReport & report, const std::string & name )
+{
+  for( const auto & dimension : report.perDimension )
+  {
+    if( dimension.first == name )
+    {
+      return &dimension.second;
+    }
+  }
+  return nullptr;
+}
+
+}
+
+TEST( OperationCounterTests, CountsPerOperation )
+{
+  resetOperationCounts();
+
+  Length< double > a { 2.0 };
+  Length< double > b { 3.0 };
+  Time< double > t { 4.0 };
+
+  auto c = a + b;
+  c = c - a;
+  c += b;
+  c -= a;
+  auto area = a * b;
+  auto speed = a / t;
+  auto ratio = area / ( a * b );
+
+  OperationReport const report = collectOperationCounts();
+  EXPECT_EQ( report.count( Operation::Add ), 1u );
+  EXPECT_EQ( report.count( Operation::Subtract ), 1u );
+  EXPECT_EQ( report.count( Operation::AddAssign ), 1u );
+  EXPECT_EQ( report.count( Operation::SubtractAssign ), 1u );
+  EXPECT_EQ( report.count( Operation::Multiply ), 2u );
+  EXPECT_EQ( report.count( Operation::Divide ), 2u );
+  EXPECT_EQ( report.total(), 8u );
+
+  EXPECT_DOUBLE_EQ( speed.value, 0.5 );
+  EXPECT_DOUBLE_EQ( ratio.value, 1.0 );
+}
+
+TEST( OperationCounterTests, CountsPerDimension )
+{
+  resetOperationCounts();
+
+  Length< double > a { 2.0 };
+  Time< double > t { 4.0 };
+  Velocity< double > v = a / t;
+  Velocity< double > w = v + v;
+  w += v;
+  Area< double > area = a * a;
+  Scalar< double > ratio = area / area;
+  EXPECT_DOUBLE_EQ( ratio.value + w.value, 2.5 );
+
+  OperationReport const report = collectOperationCounts();
+
+  OperationCounts const * velocity = findDimension( report, "L^1 T^-1" );
+  ASSERT_NE( velocity, nullptr );
+  EXPECT_EQ( ( *velocity )[ static_cast< int >( Operation::Divide ) ], 1u );
+  EXPECT_EQ( ( *velocity )[ static_cast< int >( Operation::Add ) ], 1u );
+  EXPECT_EQ( ( *velocity )[ static_cast< int >( Operation::AddAssign ) ], 1u );
+
+  OperationCounts const * areaCounts = findDimension( report, "L^2" );
+  ASSERT_NE( areaCounts, nullptr );
+  EXPECT_EQ( ( *areaCounts )[ static_cast< int >( Operation::Multiply ) ], 1u );
+
+  OperationCounts const * dimensionless = findDimension( report, "1" );
+  ASSERT_NE( dimensionless, nullptr );
+  EXPECT_EQ( ( *dimensionless )[ static_cast< int >( Operation::Divide ) ], 1u );
+
+  std::ostringstream os;
+  os << report;
+  EXPECT_NE( os.str().find( "[L^1 T^-1]" ), std::string::npos );
+}
+
+TEST( OperationCounterTests, MergesThreads )
+{
+  resetOperationCounts();
+
+  int const numThreads = 4;
+  int const numIterations = 1000;
+  std::vector< std::thread > threads;
+  for( int i = 0; i < numThreads; ++i )
+  {
+    threads.emplace_back( [numIterations]()
+    {
+      Mass< double > m { 1.0 };
+      Mass< double > sum { 0.0 };
+      for( int j = 0; j < numIterations; ++j )
+      {
+        sum += m;
+      }
+      EXPECT_DOUBLE_EQ( sum.value, numIterations );
+    } );
+  }
+  for( std::thread & thread : threads )
+  {
+    thread.join();
+  }
+
+  // Counts of exited threads are retained
+  OperationReport const report = collectOperationCounts();
+  EXPECT_EQ( report.count( Operation::AddAssign ), std::uint64_t( numThreads * numIterations ) );
+}
+
+int main( int argc, char ** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
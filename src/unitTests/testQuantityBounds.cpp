@@ -0,0 +1,127 @@
+// Also set by the UNITGUARD_ENABLE_BOUNDS_CHECKS CMake option
+#if ! defined( UNITGUARD_ENABLE_BOUNDS_CHECKS )
+#define UNITGUARD_ENABLE_BOUNDS_CHECKS
+#endif
+
+#include <gtest/gtest.h>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../QuantityBounds.hpp"
+
+using namespace UnitGuard;
+
+namespace
+{
+
+std::vector< Temp< double > > temperatures( std::size_t size )
+{
+  std::vector< Temp< double > > result;
+  for( std::size_t i = 0; i < size; ++i )
+  {
+    result.emplace_back( 273.15 + double( i ) );
+  }
+  return result;
+}
+
+}
+
+TEST( QuantityBoundsTests, AcceptsValuesInsideBounds )
+{
+  // Sizes around the lane width exercise both the blocked loop and the tail
+  for( std::size_t size : { 0u, 1u, 3u, 4u, 5u, 17u, 1000u } )
+  {
+    std::vector< Temp< double > > t = temperatures( size );
+    EXPECT_NO_THROW( checkBounds( QuantitySpan( t ) ) );
+  }
+
+  std::vector< Temp< double > > zero { Temp< double >( 0.0 ) };
+  EXPECT_NO_THROW( checkBounds( QuantitySpan( zero ) ) );
+}
+
+TEST( QuantityBoundsTests, RejectsNegativeTemperature )
+{
+  for( std::size_t bad : { 0u, 2u, 4u, 11u, 16u } )
+  {
+    std::vector< Temp< double > > t = temperatures( 17 );
+    t[ bad ] = Temp< double >( -1.0 );
+    try
+    {
+      checkBounds( QuantitySpan( t ) );
+      FAIL() << "No exception for index " << bad;
+    }
+    catch( const std::out_of_range & e )
+    {
+      std::string const message = e.what();
+      EXPECT_NE( message.find( "index " + std::to_string( bad ) ), std::string::npos ) << message;
+      EXPECT_NE( message.find( "[K^1]" ), std::string::npos ) << message;
+    }
+  }
+}
+
+TEST( QuantityBoundsTests, RejectsNonFiniteValues )
+{
+  for( double bad : { std::numeric_limits< double >::quiet_NaN(), std::numeric_limits< double >::infinity() } )
+  {
+    for( std::size_t index : { 0u, 5u, 8u } )
+    {
+      std::vector< Temp< double > > t = temperatures( 9 );
+      t[ index ] = Temp< double >( bad );
+      EXPECT_THROW( checkBounds( QuantitySpan( t ) ), std::out_of_range );
+      EXPECT_EQ( findOutOfBounds< DimensionBounds< TemperatureDimension > >( QuantitySpan( t ) ), index );
+    }
+  }
+}
+
+TEST( QuantityBoundsTests, UnboundedDimensionsAreNotChecked )
+{
+  std::vector< Length< double > > l { Length< double >( -1.0e30 ), Length< double >( 1.0e30 ) };
+  EXPECT_NO_THROW( checkBounds( QuantitySpan( l ) ) );
+}
+
+TEST( QuantityBoundsTests, ExplicitPolicy )
+{
+  std::vector< Quantity< double, Dimensionless > > porosity( 6, Quantity< double, Dimensionless >( 0.25 ) );
+  EXPECT_NO_THROW( checkBounds< UnitIntervalBounds >( QuantitySpan( porosity ) ) );
+
+  porosity[ 5 ] = Quantity< double, Dimensionless >( 1.5 );
+  EXPECT_THROW( checkBounds< UnitIntervalBounds >( QuantitySpan( porosity ) ), std::out_of_range );
+  // Dimensionless values are unbounded unless asked for
+  EXPECT_NO_THROW( checkBounds( QuantitySpan( porosity ) ) );
+}
+
+TEST( QuantityBoundsTests, AssignChecked )
+{
+  std::vector< Temp< double > > const src = temperatures( 10 );
+  std::vector< Temp< double > > dst( 10, Temp< double >( 0.0 ) );
+  assignChecked( QuantitySpan( dst ), QuantitySpan( src ) );
+  EXPECT_DOUBLE_EQ( static_cast< double >( dst[ 9 ] ), 282.15 );
+
+  std::vector< Temp< double > > bad = src;
+  bad[ 3 ] = Temp< double >( -5.0 );
+  EXPECT_THROW( assignChecked( QuantitySpan( dst ), QuantitySpan( bad ) ), std::out_of_range );
+
+  std::vector< Temp< double > > small( 2, Temp< double >( 0.0 ) );
+  EXPECT_THROW( assignChecked( QuantitySpan( small ), QuantitySpan( src ) ), std::invalid_argument );
+}
+
+TEST( QuantityBoundsTests, TransformChecked )
+{
+  std::vector< Temp< double > > const t = temperatures( 10 );
+  std::vector< Temp< double > > const dt( 10, Temp< double >( -300.0 ) );
+  std::vector< Temp< double > > out( 10, Temp< double >( 0.0 ) );
+
+  auto const add = []( const Temp< double > & a, const Temp< double > & b ) { return a + b; };
+  EXPECT_NO_THROW( transformChecked( QuantitySpan( out ), add, QuantitySpan( t ), QuantitySpan( t ) ) );
+  EXPECT_DOUBLE_EQ( static_cast< double >( out[ 0 ] ), 2.0 * 273.15 );
+
+  // 273.15 + i - 300 is negative for the first values
+  EXPECT_THROW( transformChecked( QuantitySpan( out ), add, QuantitySpan( t ), QuantitySpan( dt ) ), std::out_of_range );
+}
+
+int main( int argc, char ** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+// The same calls as testQuantityBounds.cpp without UNITGUARD_ENABLE_BOUNDS_CHECKS, even when the CMake option is ON
+#undef UNITGUARD_ENABLE_BOUNDS_CHECKS
+
+#include <gtest/gtest.h>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "../QuantityBounds.hpp"
+
+using namespace UnitGuard;
+
+TEST( QuantityBoundsDisabledTests, CheckBoundsIsEmpty )
+{
+  std::vector< Temp< double > > t { Temp< double >( 273.15 ), Temp< double >( -1.0 ),
+                                    Temp< double >( std::numeric_limits< double >::quiet_NaN() ) };
+  EXPECT_NO_THROW( checkBounds( QuantitySpan( t ) ) );
+
+  std::vector< Quantity< double, Dimensionless > > porosity( 3, Quantity< double, Dimensionless >( 1.5 ) );
+  EXPECT_NO_THROW( checkBounds< UnitIntervalBounds >( QuantitySpan( porosity ) ) );
+}
+
+TEST( QuantityBoundsDisabledTests, AssignCheckedIsACopy )
+{
+  std::vector< Temp< double > > const src { Temp< double >( 300.0 ), Temp< double >( -5.0 ), Temp< double >( 0.0 ) };
+  std::vector< Temp< double > > dst( 3, Temp< double >( 1.0 ) );
+  EXPECT_NO_THROW( assignChecked( QuantitySpan( dst ), QuantitySpan( src ) ) );
+  for( std::size_t i = 0; i < src.size(); ++i )
+  {
+    EXPECT_EQ( static_cast< double >( dst[ i ] ), static_cast< double >( src[ i ] ) );
+  }
+
+  // Size mismatches are argument errors, they are still reported
+  std::vector< Temp< double > > small( 2, Temp< double >( 0.0 ) );
+  EXPECT_THROW( assignChecked( QuantitySpan( small ), QuantitySpan( src ) ), std::invalid_argument );
+}
+
+TEST( QuantityBoundsDisabledTests, TransformCheckedIsATransform )
+{
+  std::vector< Temp< double > > const t { Temp< double >( 273.15 ), Temp< double >( 400.0 ) };
+  std::vector< Temp< double > > const dt( 2, Temp< double >( -300.0 ) );
+  std::vector< Temp< double > > out( 2, Temp< double >( 0.0 ) );
+
+  auto const add = []( const Temp< double > & a, const Temp< double > & b ) { return a + b; };
+  EXPECT_NO_THROW( transformChecked( QuantitySpan( out ), add, QuantitySpan( t ), QuantitySpan( dt ) ) );
+  EXPECT_DOUBLE_EQ( static_cast< double >( out[ 0 ] ), 273.15 - 300.0 );
+  EXPECT_DOUBLE_EQ( static_cast< double >( out[ 1 ] ), 100.0 );
+}
+
+int main( int argc, char ** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
\ No newline at end of file
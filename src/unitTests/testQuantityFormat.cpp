@@ -0,0 +1,33 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include "../Quantity.hpp"
+#include "../QuantityFormat.hpp"
+
+using namespace UnitGuard;
+
+TEST( QuantityFormatTests, DimensionString )
+{
+  EXPECT_EQ( dimensionString< Dimensionless >(), "1" );
+  EXPECT_EQ( dimensionString< LengthDimension >(), "L^1" );
+  EXPECT_EQ( dimensionString< PressureDimension >(), "M^1 L^-1 T^-2" );
+  EXPECT_EQ( dimensionString< EntropyDimension >(), "M^1 L^2 T^-2 K^-1" );
+
+  // Canonical order, whatever the order of the Power pack
+  EXPECT_EQ( ( dimensionString< Unit< Power< TimeTag, -1 >, Power< LengthTag, 1 > > >() ), "L^1 T^-1" );
+}
+
+TEST( QuantityFormatTests, Printing )
+{
+  Velocity< double > const v { 2.5 };
+  EXPECT_EQ( to_string( v ), std::to_string( 2.5 ) );
+
+  std::ostringstream os;
+  os << v;
+  EXPECT_EQ( os.str(), "2.5 [L^1 T^-1]" );
+}
+
+int main( int argc, char ** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
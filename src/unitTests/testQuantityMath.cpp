@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include "../QuantityMath.hpp"
+
+using namespace UnitGuard;
+
+TEST( QuantityMathTests, ConstexprFunctions )
+{
+  // Material constants fold at compile time
+  constexpr Length< double > a { -3.0 };
+  constexpr Length< double > b { 4.0 };
+
+  constexpr Length< double > absA = abs( a );
+  constexpr Length< double > absNegativeZero = abs( Length< double >( -0.0 ) );
+  constexpr Length< double > absNegativeNaN = abs( Length< double >( -std::numeric_limits< double >::quiet_NaN() ) );
+  constexpr Length< double > smaller = min( a, b );
+  constexpr Length< double > larger = max( a, b );
+  constexpr Length< double > clamped = clamp( Length< double >( 10.0 ), a, b );
+  constexpr Volume< double > cube = pow< 3 >( b );
+  constexpr Quantity< double, Unit< Power< LengthTag, -2 > > > inverseSquare = pow< -2 >( b );
+  constexpr Scalar< double > one = pow< 0 >( b );
+  constexpr Area< double > area = a * b + b * b;
+
+  static_assert( std::is_same< std::remove_const_t< decltype( cube ) >, Volume< double > >::value, "Length^3 => Volume" );
+
+  EXPECT_DOUBLE_EQ( absA.value, 3.0 );
+  // Bit-identical to the run-time std::abs, including the sign of zero
+  Length< double > negativeZero( -0.0 );
+  EXPECT_TRUE( std::signbit( negativeZero.value ) );
+  EXPECT_FALSE( std::signbit( absNegativeZero.value ) );
+  EXPECT_FALSE( std::signbit( abs( negativeZero ).value ) );
+  Length< double > negativeNaN( -std::numeric_limits< double >::quiet_NaN() );
+  EXPECT_TRUE( std::signbit( negativeNaN.value ) );
+  EXPECT_TRUE( std::isnan( absNegativeNaN.value ) );
+  EXPECT_FALSE( std::signbit( absNegativeNaN.value ) );
+  EXPECT_FALSE( std::signbit( abs( negativeNaN ).value ) );
+  EXPECT_DOUBLE_EQ( smaller.value, -3.0 );
+  EXPECT_DOUBLE_EQ( larger.value, 4.0 );
+  EXPECT_DOUBLE_EQ( clamped.value, 4.0 );
+  EXPECT_DOUBLE_EQ( cube.value, 64.0 );
+  EXPECT_DOUBLE_EQ( inverseSquare.value, 1.0 / 16.0 );
+  EXPECT_DOUBLE_EQ( one.value, 1.0 );
+  EXPECT_DOUBLE_EQ( area.value, 4.0 );
+}
+
+TEST( QuantityMathTests, RuntimeFunctions )
+{
+  Length< double > const a { -3.0 };
+  Length< double > const b { 4.0 };
+
+  // Same results as the raw calls
+  EXPECT_DOUBLE_EQ( abs( a ).value, std::abs( -3.0 ) );
+  EXPECT_DOUBLE_EQ( hypot( a, b ).value, 5.0 );
+  EXPECT_DOUBLE_EQ( hypot( a, b, Length< double >( 12.0 ) ).value, 13.0 );
+
+  // The unit order of the arguments does not matter, only the dimension
+  Quantity< double, Unit< Power< TimeTag, -1 >, Power< LengthTag, 1 > > > const w { 1.0 };
+  Velocity< double > const v { 2.0 };
+  EXPECT_DOUBLE_EQ( max( v, w ).value, 2.0 );
+  EXPECT_DOUBLE_EQ( min( v, w ).value, 1.0 );
+
+  // fma( a, b, c ) requires c to have the units of a * b
+  Time< double > const t { 3.0 };
+  auto const distance = fma( v, t, Length< double >( 1.0 ) );
+  static_assert( are_same_units< typename Multiply< VelocityDimension, TimeDimension >::type, LengthDimension >::value, "Velocity * Time => Length" );
+  EXPECT_DOUBLE_EQ( static_cast< double >( distance ), 7.0 );
+
+  // exp and log take dimensionless ratios
+  Energy< double > const activation { 2.0 };
+  Energy< double > const thermal { 4.0 };
+  Scalar< double > const boltzmann = exp( Scalar< double >( 0.0 ) - activation / thermal );
+  EXPECT_DOUBLE_EQ( boltzmann.value, std::exp( -0.5 ) );
+  EXPECT_DOUBLE_EQ( log( boltzmann ).value, -0.5 );
+}
+
+int main( int argc, char ** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <type_traits>
+#include <vector>
+#include "../QuantitySpan.hpp"
+
+using namespace UnitGuard;
+
+TEST( QuantitySpanTests, ViewsContainer )
+{
+  std::vector< Length< double > > lengths { Length< double >( 1.0 ), Length< double >( 2.0 ), Length< double >( 3.0 ) };
+
+  QuantitySpan span( lengths );
+  static_assert( std::is_same< decltype( span ), QuantitySpan< double, LengthDimension > >::value, "Deduced a mutable Length span" );
+  EXPECT_EQ( span.size(), 3u );
+  EXPECT_DOUBLE_EQ( static_cast< double >( span[ 1 ] ), 2.0 );
+
+  span[ 1 ] = Length< double >( 5.0 );
+  EXPECT_DOUBLE_EQ( static_cast< double >( lengths[ 1 ] ), 5.0 );
+
+  // The raw values alias the quantities
+  span.values()[ 2 ] = 7.0;
+  EXPECT_DOUBLE_EQ( static_cast< double >( lengths[ 2 ] ), 7.0 );
+
+  double sum = 0.0;
+  for( const Length< double > & l : span.subspan( 1, 2 ) )
+  {
+    sum += static_cast< double >( l );
+  }
+  EXPECT_DOUBLE_EQ( sum, 12.0 );
+}
+
+TEST( QuantitySpanTests, ConstViews )
+{
+  std::vector< Time< double > > const times { Time< double >( 1.0 ), Time< double >( 2.0 ) };
+
+  QuantitySpan span( times );
+  static_assert( std::is_same< decltype( span ), QuantitySpan< const double, TimeDimension > >::value, "Deduced a read-only Time span" );
+  static_assert( std::is_same< decltype( span.values() ), const double * >::value, "Read-only span exposes const values" );
+
+  // Mutable spans convert to read-only ones, but not the other way around
+  std::vector< Time< double > > mutableTimes( times );
+  QuantitySpan< const double, TimeDimension > const readOnly = QuantitySpan< double, TimeDimension >( mutableTimes );
+  EXPECT_EQ( readOnly.size(), 2u );
+  static_assert( !std::is_convertible< QuantitySpan< const double, TimeDimension >, QuantitySpan< double, TimeDimension > >::value, "Cannot drop const" );
+  static_assert( !std::is_convertible< QuantitySpan< double, TimeDimension >, QuantitySpan< double, LengthDimension > >::value, "Cannot change unit" );
+}
+
+int main( int argc, char ** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
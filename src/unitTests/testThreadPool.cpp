@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../ThreadPool.hpp"
+
+using namespace UnitGuard;
+
+TEST( ThreadPoolTests, RunsEveryChunkOnce )
+{
+  for( std::size_t numThreads : { 1u, 2u, 4u } )
+  {
+    ThreadPool pool( numThreads );
+    EXPECT_EQ( pool.numThreads(), numThreads );
+
+    std::vector< std::atomic< int > > counts( 100 );
+    pool.forEachChunk( counts.size(), [&]( std::size_t chunk ) { counts[ chunk ].fetch_add( 1 ); } );
+    for( const auto & count : counts )
+    {
+      EXPECT_EQ( count.load(), 1 );
+    }
+  }
+
+  EXPECT_THROW( ThreadPool( 0 ), std::invalid_argument );
+}
+
+TEST( ThreadPoolTests, PinnedChunksRunOnTheirOwner )
+{
+  ThreadPool pool( 4 );
+  std::size_t const numChunks = 16;
+  std::vector< std::thread::id > ran( numChunks );
+  pool.forEachChunk( numChunks, [&]( std::size_t chunk ) { ran[ chunk ] = std::this_thread::get_id(); }, true );
+
+  // Chunks dealt to the same thread ran on the same thread, chunks of different threads did not
+  for( std::size_t a = 0; a < numChunks; ++a )
+  {
+    for( std::size_t b = 0; b < numChunks; ++b )
+    {
+      EXPECT_EQ( ran[ a ] == ran[ b ], pool.owner( a, numChunks ) == pool.owner( b, numChunks ) );
+    }
+  }
+  EXPECT_EQ( ran[ 0 ], std::this_thread::get_id() );
+}
+
+TEST( ThreadPoolTests, RethrowsFromChunks )
+{
+  ThreadPool pool( 3 );
+  std::atomic< int > ran { 0 };
+  EXPECT_THROW( pool.forEachChunk( 50, [&]( std::size_t chunk )
+  {
+    ++ran;
+    if( chunk == 7 )
+    {
+      throw std::runtime_error( "chunk failed" );
+    }
+  } ), std::runtime_error );
+  EXPECT_GE( ran.load(), 1 );
+
+  // The pool is still usable
+  std::atomic< int > after { 0 };
+  pool.forEachChunk( 10, [&]( std::size_t ) { ++after; } );
+  EXPECT_EQ( after.load(), 10 );
+}
+
+TEST( ThreadPoolTests, NestedParallelism )
+{
+  ThreadPool pool( 3 );
+  std::atomic< int > total { 0 };
+  pool.forEachChunk( 8, [&]( std::size_t )
+  {
+    pool.forEachChunk( 8, [&]( std::size_t ) { ++total; } );
+  } );
+  EXPECT_EQ( total.load(), 64 );
+}
+
+TEST( ThreadPoolTests, PartitionIsCacheLineAligned )
+{
+  std::vector< Length< double > > lengths( 100003, Length< double >( 0.0 ) );
+  // Start off a cache line boundary on purpose
+  QuantitySpan< double, LengthDimension > const span = QuantitySpan( lengths ).subspan( 3, 100000 );
+  ChunkPartition const partition( span.data(), span.size(), sizeof( Length< double > ), 13 );
+
+  EXPECT_EQ( partition.begin( 0 ), 0u );
+  EXPECT_EQ( partition.end( partition.numChunks() - 1 ), span.size() );
+  for( std::size_t chunk = 1; chunk < partition.numChunks(); ++chunk )
+  {
+    EXPECT_EQ( partition.end( chunk - 1 ), partition.begin( chunk ) );
+    std::uintptr_t const address = reinterpret_cast< std::uintptr_t >( span.data() + partition.begin( chunk ) );
+    EXPECT_EQ( address % cacheLineSize, 0u );
+  }
+}
+
+TEST( ThreadPoolTests, ParallelTransform )
+{
+  ThreadPool pool( 4 );
+  std::size_t const size = 50000;
+  std::vector< Length< double > > distance( size, Length< double >( 0.0 ) );
+  std::vector< Time< double > > time( size, Time< double >( 0.0 ) );
+  std::vector< Velocity< double > > velocity( size, Velocity< double >( 0.0 ) );
+
+  parallelInitialize( pool, QuantitySpan( distance ), []( std::size_t i ) { return Length< double >( double( i ) ); } );
+  parallelFill( pool, QuantitySpan( time ), Time< double >( 2.0 ) );
+  parallelTransform( pool, QuantitySpan( velocity ),
+                     []( const Length< double > & l, const Time< double > & t ) { return l / t; },
+                     QuantitySpan( distance ), QuantitySpan( time ) );
+
+  for( std::size_t i = 0; i < size; ++i )
+  {
+    EXPECT_DOUBLE_EQ( static_cast< double >( velocity[ i ] ), 0.5 * double( i ) );
+  }
+
+  std::vector< Time< double > > small( 3, Time< double >( 1.0 ) );
+  EXPECT_THROW( parallelTransform( pool, QuantitySpan( velocity ),
+                                   []( const Length< double > & l, const Time< double > & t ) { return l / t; },
+                                   QuantitySpan( distance ), QuantitySpan( small ) ), std::invalid_argument );
+}
+
+TEST( ThreadPoolTests, ParallelFor )
+{
+  ThreadPool pool( 4 );
+  std::vector< Length< double > > lengths( 30000, Length< double >( 1.0 ) );
+  parallelFor( pool, QuantitySpan( lengths ), []( Length< double > & l ) { l += Length< double >( 2.0 ); } );
+  for( const auto & l : lengths )
+  {
+    EXPECT_DOUBLE_EQ( static_cast< double >( l ), 3.0 );
+  }
+
+  std::vector< Length< double > > empty;
+  parallelFor( pool, QuantitySpan( empty ), []( Length< double > & ) { FAIL(); } );
+}
+
+int main( int argc, char ** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
\ No newline at end of file
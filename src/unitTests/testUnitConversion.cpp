@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "../UnitConversion.hpp"
+
+using namespace UnitGuard;
+
+TEST( UnitExponentsTests, DenseExponents )
+{
+  // PressureDimension = M^1 * L^-1 * T^-2
+  constexpr DimensionVector pressure = UnitExponents< PressureDimension >::value;
+  static_assert( pressure[ 0 ] == 1 && pressure[ 1 ] == -1 && pressure[ 2 ] == -2 && pressure[ 4 ] == 0, "PressureDimension exponents mismatch!" );
+
+  // Ordering of the Powers in the pack does not matter
+  using Shuffled = Unit< Power< TimeTag, -2 >, Power< MassTag, 1 >, Power< LengthTag, -1 > >;
+  static_assert( UnitExponents< Shuffled >::value == UnitExponents< PressureDimension >::value, "Exponents should not depend on pack order" );
+
+  static_assert( UnitExponents< Dimensionless >::value == DimensionVector {}, "Dimensionless has no exponents" );
+  SUCCEED();
+}
+
+TEST( ConversionEngineTests, ScaleAndOffset )
+{
+  ConversionEngine engine;
+  UnitId const pascal = engine.registerUnit< PressureDimension >();
+  UnitId const bar = engine.registerUnit< PressureDimension >( 1.0e5 );
+  UnitId const kelvin = engine.registerUnit< TemperatureDimension >();
+  UnitId const celsius = engine.registerUnit< TemperatureDimension >( 1.0, 273.15 );
+  UnitId const fahrenheit = engine.registerUnit< TemperatureDimension >( 5.0 / 9.0, 273.15 - 32.0 * 5.0 / 9.0 );
+
+  ConversionFactor const barToPascal = engine.lookup( bar, pascal );
+  EXPECT_DOUBLE_EQ( barToPascal.factor, 1.0e5 );
+  EXPECT_DOUBLE_EQ( barToPascal.offset, 0.0 );
+  EXPECT_DOUBLE_EQ( engine.lookup( pascal, bar ).apply( 2.5e5 ), 2.5 );
+
+  EXPECT_DOUBLE_EQ( engine.lookup( celsius, kelvin ).apply( 25.0 ), 298.15 );
+  EXPECT_NEAR( engine.lookup( celsius, fahrenheit ).apply( 100.0 ), 212.0, 1.0e-12 );
+  EXPECT_NEAR( engine.lookup( fahrenheit, celsius ).apply( 32.0 ), 0.0, 1.0e-12 );
+
+  // Quantities keep their dimension through a conversion
+  Temp< double > const t = engine.convert( Temp< double >( 0.0 ), celsius, kelvin );
+  EXPECT_DOUBLE_EQ( t.value, 273.15 );
+}
+
+TEST( ConversionEngineTests, CachedLookupIsStable )
+{
+  ConversionEngine engine( 4 );
+  std::vector< UnitId > lengths;
+  for( int i = 1; i <= 8; ++i )
+  {
+    lengths.push_back( engine.registerUnit< LengthDimension >( i ) );
+  }
+
+  // More pairs than the cache holds, misses past capacity are still answered correctly
+  for( int pass = 0; pass < 2; ++pass )
+  {
+    for( std::size_t i = 0; i < lengths.size(); ++i )
+    {
+      for( std::size_t j = 0; j < lengths.size(); ++j )
+      {
+        EXPECT_DOUBLE_EQ( engine.lookup( lengths[ i ], lengths[ j ] ).factor, double( i + 1 ) / double( j + 1 ) );
+      }
+    }
+  }
+}
+
+TEST( ConversionEngineTests, Errors )
+{
+  ConversionEngine engine;
+  UnitId const meter = engine.registerUnit< LengthDimension >();
+  UnitId const second = engine.registerUnit< TimeDimension >();
+
+  EXPECT_THROW( engine.lookup( meter, second ), std::invalid_argument );
+  EXPECT_THROW( engine.lookup( meter, 0 ), std::out_of_range );
+  EXPECT_THROW( engine.lookup( 0, meter ), std::out_of_range );
+  EXPECT_THROW( engine.lookup( 0, 0 ), std::out_of_range );
+  EXPECT_THROW( engine.lookup( meter, 42 ), std::out_of_range );
+  EXPECT_THROW( engine.registerUnit< LengthDimension >( 0.0 ), std::invalid_argument );
+}
+
+TEST( ConversionEngineTests, QuantityDimensionMismatch )
+{
+  ConversionEngine engine;
+  UnitId const kelvin = engine.registerUnit< TemperatureDimension >();
+  UnitId const celsius = engine.registerUnit< TemperatureDimension >( 1.0, 273.15 );
+
+  // Once on the miss path, once on the cache hit
+  EXPECT_THROW( engine.convert( Pressure< double >( 1.0e5 ), celsius, kelvin ), std::invalid_argument );
+  EXPECT_THROW( engine.convert( Pressure< double >( 1.0e5 ), celsius, kelvin ), std::invalid_argument );
+  EXPECT_DOUBLE_EQ( engine.convert( Temp< double >( 25.0 ), celsius, kelvin ).value, 298.15 );
+}
+
+TEST( ConversionEngineTests, ConcurrentLookup )
+{
+  ConversionEngine engine;
+  std::vector< UnitId > pressures;
+  for( int i = 1; i <= 16; ++i )
+  {
+    pressures.push_back( engine.registerUnit< PressureDimension >( i ) );
+  }
+
+  // gtest assertions are thread-safe where pthreads are available
+  std::vector< std::thread > threads;
+  for( int t = 0; t < 4; ++t )
+  {
+    threads.emplace_back( [&]()
+    {
+      for( int rep = 0; rep < 100; ++rep )
+      {
+        for( std::size_t i = 0; i < pressures.size(); ++i )
+        {
+          for( std::size_t j = 0; j < pressures.size(); ++j )
+          {
+            EXPECT_DOUBLE_EQ( engine.lookup( pressures[ i ], pressures[ j ] ).factor, double( i + 1 ) / double( j + 1 ) );
+          }
+        }
+      }
+    } );
+  }
+  for( std::thread & thread : threads )
+  {
+    thread.join();
+  }
+}
+
+int main( int argc, char ** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -130,6 +130,20 @@ TEST( QuantityTests, CrossDimensionArithmetic )
   EXPECT_DOUBLE_EQ( static_cast< double >( entropy ), 1000.0 / 200.0 );
 }
 
+TEST( QuantityTests, CompoundAssignment )
+{
+  Velocity< double > v {1.0};
+
+  // The same dimension spelled in a different order is accepted
+  Quantity< double, Unit< Power< TimeTag, -1 >, Power< LengthTag, 1 > > > w {2.0};
+  v += w;
+  EXPECT_DOUBLE_EQ( static_cast< double >( v ), 3.0 );
+  v -= w;
+  EXPECT_DOUBLE_EQ( static_cast< double >( v ), 1.0 );
+  v = w;
+  EXPECT_DOUBLE_EQ( static_cast< double >( v ), 2.0 );
+}
+
 int main( int argc, char ** argv )
 {
   ::testing::InitGoogleTest( &argc, argv );